@@ -37,6 +37,16 @@ __asm volatile ("nop");
 #endif
 
 #include "MCP3221.h"
+#include "utility/MCP3221Filters.h"
+
+/*==============================================================================================================*
+    IDENTITY CALIBRATION TABLE (SHARED BY UNCALIBRATED DEVICES)
+ *==============================================================================================================*/
+
+static const uint16_t calIdentity[CAL_KNOTS] = {
+       0,  256,  512,  768, 1024, 1280, 1536, 1792,
+    2048, 2304, 2560, 2816, 3072, 3328, 3584, 3840, 4096
+};
 
 /*==============================================================================================================*
     CONSTRUCTOR
@@ -52,13 +62,28 @@ MCP3221::MCP3221(
      smoothing_t     smoothingMethod,
      byte            numSamples) :
      _devAddr(devAddr),
-     _vRef(vRef),
-     _alpha(alpha),
      _voltageInput(voltageInput),
      _smoothing(smoothingMethod),
-     _numSamples(numSamples)
+     _numSamples(constrain(numSamples, MIN_NUM_SAMPLES, MAX_NUM_SAMPLES)),
+     _vLut(NULL),
+     _calTable(calIdentity),
+     _vRef(vRef),
+     _samples(_ownSamples),
+     _samplesSize(MAX_NUM_SAMPLES),
+     _bus(&MCP3221_defaultI2C()),
+     _comStats(NULL),
+     _ring(NULL),
+     _stages(NULL),
+     _asyncChunk(1),
+     _asyncBusy(false),
+     _maxRetries(DEFAULT_MAX_RETRIES),
+     _sampleStatus(SAMPLE_FAILED),
+     _retryTime(DEFAULT_RETRY_TIME),
+     _lastData(0),
+     _lastOversampled(NO_OVERSAMPLED)
      {
-        memset(_samples, 0, sizeof(_samples));
+        setAlpha(alpha);
+        resetFilters();
         if (((res1 != 0) && (res2 != 0)) && (_voltageInput == VOLTAGE_INPUT_12V)) {
             _res1 = res1;
             _res2 = res2;
@@ -69,7 +94,9 @@ MCP3221::MCP3221(
             _res1 = DEFAULT_RES_1;
             _res2 = DEFAULT_RES_2;
     }
+    updateVoltageScale();
     _comBuffer = COM_SUCCESS;
+    resetComStats();
 }
 
 /*==============================================================================================================*
@@ -85,8 +112,10 @@ MCP3221::~MCP3221() {}
 // See meaning of I2C Error Code values in README
 
 byte MCP3221::ping() {
-    Wire.beginTransmission(_devAddr);
-    return _comBuffer = Wire.endTransmission();
+    _bus->beginTransmission(_devAddr);
+    _comBuffer = _bus->endTransmission();
+    if (_comStats) _comStats->comCodes[min(_comBuffer, NUM_COM_CODES - 1)]++;
+    return _comBuffer;
 }
 
 /*==============================================================================================================*
@@ -118,11 +147,11 @@ unsigned int MCP3221::getRes2() {
  *==============================================================================================================*/
 
 unsigned int MCP3221::getAlpha() {
-    return _alpha;
+    return _ema.getAlpha();
 }
 
 /*==============================================================================================================*
-    GET NUMBER OF SAMPLES (RELEVANT ONLY FOR ROLLING-AVAREGE SMOOTHING METHOD, RANGE: 1-20 SAMPLES)
+    GET NUMBER OF SAMPLES (RELEVANT ONLY FOR ROLLING-AVAREGE SMOOTHING METHOD, RANGE: 1-32 SAMPLES)
  *==============================================================================================================*/
 
 byte MCP3221::getNumSamples() {
@@ -150,7 +179,43 @@ byte MCP3221::getSmoothing() {
  *==============================================================================================================*/
 
 unsigned int MCP3221::getData() {
-    return (_smoothing == NO_SMOOTHING) ? getRawData() : smoothData(getRawData());
+    unsigned int data;
+    readData(data);
+    return data;
+}
+
+/*==============================================================================================================*
+    READ DATA (SAME AS getData() BUT RETURNS THE SAMPLE STATUS: VALID / STALE / FAILED)
+ *==============================================================================================================*/
+
+// A failed read (after retries) never reaches the smoothing filters: the last valid reading is held (SAMPLE_STALE)
+// or, if there hasn't been one yet, 0 is returned (SAMPLE_FAILED).
+
+sample_status_t MCP3221::readData(unsigned int &data) {
+    uint16_t rawData;
+    bool success = readRawData(&rawData, 1);
+    return storeData(success, rawData, data);
+}
+
+/*==============================================================================================================*
+    READ DATA ONCE (SAME AS readData() BUT A SINGLE I2C TRANSACTION: NO RETRIES & NO PING ON FAILURE)
+ *==============================================================================================================*/
+
+// For callers with their own failure handling (e.g. MCP3221Bus), where a dead device should cost one transaction
+// per read. getComResult() isn't updated by a failed read, as finding out why it failed would take a ping.
+
+sample_status_t MCP3221::readDataOnce(unsigned int &data) {
+    uint16_t rawData;
+    bool success = (readSamples(&rawData, 1, false) == 1);
+    return storeData(success, rawData, data);
+}
+
+/*==============================================================================================================*
+    GET SAMPLE STATUS (OF THE LATEST getData() / readData() / getVoltage() CALL)
+ *==============================================================================================================*/
+
+sample_status_t MCP3221::getSampleStatus() {
+    return (sample_status_t)_sampleStatus;
 }
 
 /*==============================================================================================================*
@@ -158,8 +223,176 @@ unsigned int MCP3221::getData() {
  *==============================================================================================================*/
 
 unsigned int MCP3221::getVoltage() {
-    if (_voltageInput == VOLTAGE_INPUT_5V) return round((_vRef / (float)DEFAULT_VREF) * getData());
-    else return round(getData() * ((float)(_res1 + _res2) / _res2));
+    return toVoltage(calibrate(getData(), 0));
+}
+
+/*==============================================================================================================*
+    GET OVERSAMPLED DATA (12 + extraBits RESULT FROM 4^extraBits RAW SAMPLES, LAST VALID RESULT ON FAILURE)
+ *==============================================================================================================*/
+
+unsigned int MCP3221::getOversampled(byte extraBits) {
+    unsigned int data;
+    readOversampled(extraBits, data);
+    return data;
+}
+
+/*==============================================================================================================*
+    READ OVERSAMPLED DATA (RETURNS SAMPLE STATUS)
+ *==============================================================================================================*/
+
+// Summing 4^n samples and dropping n bits yields n extra bits of resolution, provided the input carries at
+// least 1 LSB of noise (dither). Samples are read in bursts and bypass the smoothing filters. Each burst is
+// retried (and the bus recovered) under the same policy as readData(); if a burst still fails, the last valid
+// result is held (kept at 16 bits, so it can be returned at any number of extra bits).
+
+sample_status_t MCP3221::readOversampled(byte extraBits, unsigned int &data) {
+    uint16_t chunk[OVERSAMPLING_CHUNK];
+    extraBits = constrain(extraBits, MIN_EXTRA_BITS, MAX_EXTRA_BITS);
+    byte chunkSize = constrain(_bus->bufferSize() / DATA_BYTES, 1, OVERSAMPLING_CHUNK);
+    unsigned int remaining = 1 << (2 * extraBits);
+    unsigned long sum = 0;                                                      // max: 4095 * 256
+    while (remaining) {
+        byte request = (remaining < chunkSize) ? remaining : chunkSize;
+        if (!readRawData(chunk, request)) break;
+        for (byte i=0; i<request; i++) sum += chunk[i];
+        remaining -= request;
+    }
+    if (!remaining) {
+        _lastOversampled = ((sum + (1 << (extraBits - 1))) >> extraBits) << (MAX_EXTRA_BITS - extraBits);
+        _sampleStatus = SAMPLE_VALID;
+    } else {
+        _sampleStatus = (_lastOversampled == NO_OVERSAMPLED) ? SAMPLE_FAILED : SAMPLE_STALE;
+    }
+    data = (_lastOversampled == NO_OVERSAMPLED) ? 0 : (_lastOversampled >> (MAX_EXTRA_BITS - extraBits));
+    return (sample_status_t)_sampleStatus;
+}
+
+/*==============================================================================================================*
+    GET OVERSAMPLED VOLTAGE (IN uV)
+ *==============================================================================================================*/
+
+unsigned long MCP3221::getOversampledVoltage(byte extraBits) {
+    unsigned int rawData;
+    extraBits = constrain(extraBits, MIN_EXTRA_BITS, MAX_EXTRA_BITS);
+    if (readOversampled(extraBits, rawData) == SAMPLE_FAILED) return 0;         // no reading yet, not an offset
+    unsigned long data = calibrate(rawData, extraBits);
+    if (_vLut) {                                                                // interpolate between table codes
+        unsigned int code = data >> extraBits;
+        unsigned long low = toVoltage(code) * 1000UL;
+        unsigned long high = toVoltage(min(code + 1, 4095)) * 1000UL;
+        return low + (((high - low) * (data & ((1 << extraBits) - 1))) >> extraBits);
+    }
+    byte shift = _vShift + extraBits;
+    return ((uint64_t)data * _vScale * 1000 + ((1ULL << shift) >> 1)) >> shift;
+}
+
+/*==============================================================================================================*
+    READ BURST (MULTIPLE CONVERSIONS PER I2C TRANSACTION, RETURNS NUMBER OF SAMPLES STORED)
+ *==============================================================================================================*/
+
+// The MCP3221 keeps clocking out fresh conversions for as long as the master ACKs, so samples are requested
+// in chunks as large as the bus receive buffer allows (16 samples with the AVR Wire library) and each chunk
+// costs a single address byte. Each chunk is filtered as a block like getData() would filter single samples
+// (decimating stages leave fewer samples than were read); a failed chunk ends the burst.
+
+size_t MCP3221::readBurst(uint16_t *dst, size_t numSamples) {
+    byte chunkSize = max(_bus->bufferSize() / DATA_BYTES, 1);
+    size_t numRead = 0, numStored = 0;
+    while (numRead < numSamples) {
+        size_t remaining = numSamples - numRead;
+        byte request = (remaining < chunkSize) ? remaining : chunkSize;
+        byte received = readSamples(dst + numStored, request);
+        numRead += received;
+        numStored += filterBlock(dst + numStored, received);
+        if (received < request) break;
+    }
+    return numStored;
+}
+
+/*==============================================================================================================*
+    START ASYNCHRONOUS ACQUISITION (SAMPLES ARE QUEUED IN THE GIVEN RING BUFFER)
+ *==============================================================================================================*/
+
+// Raw samples are pushed into the ring by poll() or, with an interrupt-driven bus, by onTransferComplete()
+// from the bus's completion ISR. Smoothing is deferred until the application drains the ring with read().
+// The library itself ships no interrupt-driven bus: the 'Wire' adapter blocks in requestFrom(), so poll()
+// performs the whole transfer before returning. Acquisition only runs in the background with a custom
+// MCP3221_I2C implementation that overrides startRequest() / requestPending() and calls onTransferComplete().
+// Restarting while a transfer is still in flight first waits for it to finish (its samples are dropped).
+
+void MCP3221::startAsync(MCP3221_RingBase &ring, byte samplesPerTransfer) {
+    if (_asyncBusy) stopAsync();
+    byte maxChunk = max(_bus->bufferSize() / DATA_BYTES, 1);
+    _asyncChunk = constrain(samplesPerTransfer, 1, maxChunk);
+    _ring = &ring;
+}
+
+/*==============================================================================================================*
+    STOP ASYNCHRONOUS ACQUISITION
+ *==============================================================================================================*/
+
+void MCP3221::stopAsync() {
+    _ring = NULL;
+    while (_asyncBusy && _bus->requestPending());                               // let an in-flight transfer finish
+    _asyncBusy = false;
+    recordTransfers();
+}
+
+/*==============================================================================================================*
+    POLL (SERVICES ASYNCHRONOUS ACQUISITION FROM THE MAIN LOOP)
+ *==============================================================================================================*/
+
+// Also folds the transfers collected by onTransferComplete() into the I2C statistics, so with an interrupt-driven
+// bus poll() should still be called now and then.
+
+void MCP3221::poll() {
+    if (_ring && !(_asyncBusy && _bus->requestPending())) {
+        if (_asyncBusy) collectTransfer();
+        _asyncBusy = _bus->startRequest(_devAddr, _asyncChunk * DATA_BYTES);
+        if (_asyncBusy && !_bus->requestPending()) collectTransfer();           // blocking buses finish at once
+    }
+    recordTransfers();
+}
+
+/*==============================================================================================================*
+    TRANSFER COMPLETE (CALLED FROM THE COMPLETION ISR OF INTERRUPT-DRIVEN BUSES)
+ *==============================================================================================================*/
+
+// Only moves the received bytes into the ring and restarts the bus: filtering happens in read() and the
+// statistics are updated by the next poll().
+
+void MCP3221::onTransferComplete() {
+    if (!_ring || !_asyncBusy) return;
+    collectTransfer();
+    _asyncBusy = _bus->startRequest(_devAddr, _asyncChunk * DATA_BYTES);
+}
+
+/*==============================================================================================================*
+    GET NUMBER OF QUEUED SAMPLES
+ *==============================================================================================================*/
+
+byte MCP3221::available() {
+    return _ring ? _ring->available() : 0;
+}
+
+/*==============================================================================================================*
+    READ NEXT QUEUED SAMPLE (SMOOTHED; RETURNS 0 IF NONE IS AVAILABLE)
+ *==============================================================================================================*/
+
+unsigned int MCP3221::read() {
+    uint16_t sample = 0;
+    return read(&sample, 1) ? sample : 0;
+}
+
+/*==============================================================================================================*
+    READ QUEUED SAMPLES (FILTERED AS A BLOCK, RETURNS NUMBER OF SAMPLES STORED)
+ *==============================================================================================================*/
+
+size_t MCP3221::read(uint16_t *dst, size_t maxSamples) {
+    size_t numRead = 0;
+    if (!_ring) return 0;
+    while ((numRead < maxSamples) && _ring->pop(dst[numRead])) numRead++;
+    return filterBlock(dst, numRead);
 }
 
 /*==============================================================================================================*
@@ -170,6 +403,65 @@ byte MCP3221::getComResult() {
     return _comBuffer;
 }
 
+/*==============================================================================================================*
+    GET STATUS (COMPACT BINARY SNAPSHOT OF THE CURRENT SETTINGS, NO I2C TRAFFIC)
+ *==============================================================================================================*/
+
+void MCP3221::getStatus(mcp3221_status_t &status) {
+    status.devAddr = _devAddr;
+    status.comResult = _comBuffer;
+    status.voltageInput = _voltageInput;
+    status.smoothing = _smoothing;
+    status.vRef = _vRef;
+    status.res1 = _res1;
+    status.res2 = _res2;
+    status.alpha = _ema.getAlpha();
+    status.numSamples = _numSamples;
+}
+
+/*==============================================================================================================*
+    GET I2C BUS (DEFAULT: GLOBAL 'WIRE' OBJECT)
+ *==============================================================================================================*/
+
+MCP3221_I2C& MCP3221::getBus() {
+    return *_bus;
+}
+
+/*==============================================================================================================*
+    SET I2C COMMUNICATION STATISTICS (CALLER-OWNED COUNTERS, CLEARED HERE; NULL = NO STATISTICS)
+ *==============================================================================================================*/
+
+// The counters live outside the device, so instances without statistics don't carry their 70-odd bytes and
+// the class layout is the same whether statistics are used or not. Without them, each transaction costs a
+// single pointer test.
+
+void MCP3221::setComStats(mcp3221_com_stats_t *stats) {
+    _comStats = stats;
+    resetComStats();
+}
+
+/*==============================================================================================================*
+    GET I2C COMMUNICATION STATISTICS (ALL ZERO UNLESS COUNTERS WERE GIVEN TO setComStats())
+ *==============================================================================================================*/
+
+const mcp3221_com_stats_t& MCP3221::getComStats() const {
+    static const mcp3221_com_stats_t noStats = {};
+    return _comStats ? *_comStats : noStats;
+}
+
+/*==============================================================================================================*
+    RESET I2C COMMUNICATION STATISTICS
+ *==============================================================================================================*/
+
+void MCP3221::resetComStats() {
+    noInterrupts();
+    _asyncReads = _asyncSamples = _asyncShortReads = 0;
+    interrupts();
+    if (!_comStats) return;
+    memset(_comStats, 0, sizeof(*_comStats));
+    _comStats->minTime = 0xFFFFFFFF;
+}
+
 /*==============================================================================================================*
     SET REFERENCE VOLTAGE (2700mV - 5500mV)
  *==============================================================================================================*/
@@ -177,6 +469,7 @@ byte MCP3221::getComResult() {
 void MCP3221::setVref(unsigned int newVref) {                                  // PARAM RANGE: 2700-5500
     newVref = constrain(newVref, MIN_VREF, MAX_VREF);
     _vRef = newVref;
+    updateVoltageScale();
 }
 
 /*==============================================================================================================*
@@ -185,6 +478,7 @@ void MCP3221::setVref(unsigned int newVref) {                                  /
 
 void MCP3221::setRes1(unsigned int newRes1) {
     _res1 = newRes1;
+    updateVoltageScale();
 }
 
 /*==============================================================================================================*
@@ -193,6 +487,7 @@ void MCP3221::setRes1(unsigned int newRes1) {
 
 void MCP3221::setRes2(unsigned int newRes2) {
     _res2 = newRes2;
+    updateVoltageScale();
 }
 
 /*==============================================================================================================*
@@ -200,18 +495,32 @@ void MCP3221::setRes2(unsigned int newRes2) {
  *==============================================================================================================*/
 
 void MCP3221::setAlpha(unsigned int newAlpha) {                                      // PARAM RANGE: 1-256
-    newAlpha = constrain(newAlpha, MIN_ALPHA, MAX_ALPHA);
-    _alpha = newAlpha;
+    _ema.setAlpha(newAlpha);
 }
 
 /*==============================================================================================================*
     SET NUMBER OF SAMPLES (RELEVANT ONLY FOR ROLLING-AVAREGE SMOOTHING METHOD)
  *==============================================================================================================*/
 
-void MCP3221::setNumSamples(byte newNumSamples) {                                    // PARAM RANGE: 1-20
+void MCP3221::setNumSamples(byte newNumSamples) {                                    // PARAM RANGE: 1-32
     newNumSamples = constrain(newNumSamples, MIN_NUM_SAMPLES, MAX_NUM_SAMPLES);
     _numSamples = newNumSamples;
-    for (byte i=0; i<MAX_NUM_SAMPLES; i++) _samples[i] = 0;
+    resetFilters();
+}
+
+/*==============================================================================================================*
+    SET SAMPLE BUFFER (STORAGE FOR THE ROLLING-AVAREGE / MEDIAN WINDOW; NULL = THE DEVICE'S OWN)
+ *==============================================================================================================*/
+
+// By default the window is kept in the device's own MAX_NUM_SAMPLES-entry buffer. A buffer owned by the sketch
+// may be given instead (e.g. one shared by devices that never smooth at the same time); the window is then the
+// smaller of the number of samples and the buffer size.
+
+void MCP3221::setSampleBuffer(uint16_t *buffer, byte size) {
+    bool own = !buffer || !size;
+    _samples = own ? _ownSamples : buffer;
+    _samplesSize = own ? MAX_NUM_SAMPLES : size;
+    resetFilters();
 }
 
 /*==============================================================================================================*
@@ -224,14 +533,111 @@ void MCP3221::setVinput(voltage_input_t newVoltageInput) {     // PARAMS: VOLTAG
         if (!_res1) _res1 = DEFAULT_RES_1;
         if (!_res2) _res2 = DEFAULT_RES_2;
     }
+    updateVoltageScale();
 }
 
 /*==============================================================================================================*
     SET SMOOTHING METHOD
  *==============================================================================================================*/
 
-void MCP3221::setSmoothing(smoothing_t newSmoothing) {           // PARAMS: NO_SMOOTHING / ROLLING / EMAVG
+void MCP3221::setSmoothing(smoothing_t newSmoothing) {           // PARAMS: NO_SMOOTHING / ROLLING / EMAVG / MEDIAN
     _smoothing = newSmoothing;
+    resetFilters();
+}
+
+/*==============================================================================================================*
+    ADD FILTER STAGE (APPENDED TO THE PIPELINE THAT RUNS AHEAD OF THE SMOOTHING METHOD)
+ *==============================================================================================================*/
+
+// Stages are linked through their own 'next' pointer, so the pipeline needs no storage of its own; a stage
+// can therefore belong to one device only.
+
+void MCP3221::addStage(MCP3221Stage &stage) {
+    MCP3221Stage **link = &_stages;
+    while (*link) {
+        if (*link == &stage) return;                                            // already in the pipeline
+        link = &(*link)->_next;
+    }
+    stage._next = NULL;
+    *link = &stage;
+}
+
+/*==============================================================================================================*
+    CLEAR FILTER STAGES
+ *==============================================================================================================*/
+
+void MCP3221::clearStages() {
+    while (_stages) {
+        MCP3221Stage *stage = _stages;
+        _stages = stage->_next;
+        stage->_next = NULL;
+    }
+}
+
+/*==============================================================================================================*
+    SET CALIBRATION TABLE (CALIBRATED CODES AT CODES 0, 256 ... 4096; NULL = NO CORRECTION)
+ *==============================================================================================================*/
+
+// The table is normally built and held by an MCP3221Calibration object. The device only keeps a pointer to it,
+// so the table must stay in place while it's in use and its entries must not exceed MAX_CAL_CODE. Without one,
+// the shared identity table is used, so calibrated and uncalibrated readings cost the same.
+
+void MCP3221::setCalibration(const uint16_t *knots) {
+    _calTable = knots ? knots : calIdentity;
+}
+
+/*==============================================================================================================*
+    GET CALIBRATION TABLE (CAL_KNOTS ENTRIES, NULL IF NONE)
+ *==============================================================================================================*/
+
+const uint16_t* MCP3221::getCalibration() const {
+    return (_calTable == calIdentity) ? NULL : _calTable;
+}
+
+/*==============================================================================================================*
+    CALIBRATE (CORRECTS A RAW CODE, e.g. FROM getData() OR readBurst())
+ *==============================================================================================================*/
+
+unsigned int MCP3221::calibrate(unsigned int data) {
+    return calibrate((unsigned long)data, 0);
+}
+
+/*==============================================================================================================*
+    VOLTAGE TO DATA (HIGHEST CODE READING AS mV OR LESS, FOR PRECOMPUTING THRESHOLDS IN COUNTS)
+ *==============================================================================================================*/
+
+// Binary search over the 12-bit range through the same calibration & conversion as getVoltage() (table or
+// scale), so it matches whatever conversion is set up. Setup-time use only: 12 conversions per call.
+
+unsigned int MCP3221::voltageToData(unsigned int mV) {
+    unsigned int low = 0, high = 4095;
+    while (low < high) {
+        unsigned int mid = (low + high + 1) >> 1;
+        if (toVoltage(calibrate((unsigned long)mid, 0)) <= mV) low = mid;
+        else high = mid - 1;
+    }
+    return low;
+}
+
+/*==============================================================================================================*
+    SET VOLTAGE LOOK-UP TABLE (PROGMEM, 256 OR 4096 ENTRIES IN mV; NULL = USE THE PRECOMPUTED SCALE)
+ *==============================================================================================================*/
+
+// For fixed configurations the voltage of each code can be taken from a table in flash instead of being
+// calculated: a 4096-entry table (8KB) holds every code, a 256-entry table (512B) holds every 16th code and
+// is linearly interpolated. See 'extras/tools/MCP3221_LUTGen.py' for generating either table.
+
+void MCP3221::setVoltageLUT(const uint16_t *lut, unsigned int lutSize) {
+    _vLut = ((lutSize == LUT_SIZE_256) || (lutSize == LUT_SIZE_4096)) ? lut : NULL;
+    _vLutFull = (lutSize == LUT_SIZE_4096);
+}
+
+/*==============================================================================================================*
+    SET I2C BUS (E.G. A SECOND 'TwoWire' PORT OR THE MCP3221_SimI2C SIMULATOR)
+ *==============================================================================================================*/
+
+void MCP3221::setBus(MCP3221_I2C& newBus) {
+    _bus = &newBus;
 }
 
 /*==============================================================================================================*
@@ -246,18 +652,155 @@ void MCP3221::reset() {
     setRes1(0);
     setRes2(0);
     setNumSamples(DEFAULT_NUM_SAMPLES);
+    setCalibration(NULL);
+}
+
+/*==============================================================================================================*
+    SET RETRY POLICY (NUMBER OF RETRIES & OVERALL TIME BUDGET IN uS)
+ *==============================================================================================================*/
+
+void MCP3221::setRetries(byte maxRetries, unsigned int retryTime) {
+    _maxRetries = maxRetries;
+    _retryTime = retryTime;
+}
+
+/*==============================================================================================================*
+    RECOVER BUS (CLOCKS A STUCK SLAVE OFF SDA, RETURNS THE PING RESULT AFTERWARDS)
+ *==============================================================================================================*/
+
+byte MCP3221::recoverBus() {
+    _bus->recover();
+    return ping();
+}
+
+/*==============================================================================================================*
+    READ RAW DATA (WITH RETRIES, RETURNS FALSE IF ALL ATTEMPTS FAILED)
+ *==============================================================================================================*/
+
+// Retries stop at whichever comes first: the retry count or the time budget. A read failing with a bus error
+// (rather than an absent device) triggers a bus recovery before the next attempt.
+
+bool MCP3221::readRawData(uint16_t *dst, byte numSamples) {
+    unsigned long start = micros();
+    for (byte retries=0; ; retries++) {
+        if (readSamples(dst, numSamples) == numSamples) return true;
+        if ((retries >= _maxRetries) || ((micros() - start) >= _retryTime)) return false;
+        if (_comBuffer >= COM_BUS_ERROR) _bus->recover();
+        if (_comStats) _comStats->retries++;
+    }
+}
+
+/*==============================================================================================================*
+    READ SAMPLES (SINGLE I2C TRANSACTION, RETURNS NUMBER OF COMPLETE SAMPLES RECEIVED)
+ *==============================================================================================================*/
+
+byte MCP3221::readSamples(uint16_t *dst, byte numSamples, bool pingOnFail) {
+    unsigned long start = _comStats ? micros() : 0;
+    _bus->requestFrom(_devAddr, numSamples * DATA_BYTES);
+    byte received = _bus->available() / DATA_BYTES;
+    if (_comStats) recordRead(micros() - start, received, numSamples);
+    for (byte i=0; i<received; i++) {
+        dst[i] = _bus->read() << 8;                                             // upper 4 bits first
+        dst[i] |= _bus->read();
+    }
+    if (received == numSamples) _comBuffer = COM_SUCCESS;
+    else if (pingOnFail) ping();
+    return received;
+}
+
+/*==============================================================================================================*
+    STORE DATA (FILTERS A SUCCESSFUL READING, OR HOLDS THE LAST ONE, RETURNS THE SAMPLE STATUS)
+ *==============================================================================================================*/
+
+sample_status_t MCP3221::storeData(bool success, uint16_t rawData, unsigned int &data) {
+    if (success) {
+        unsigned int filteredData = rawData;
+        if (filterData(filteredData)) _lastData = filteredData;                 // a decimating stage may hold it back
+        _sampleStatus = SAMPLE_VALID;
+    } else if (_sampleStatus == SAMPLE_VALID) {
+        _sampleStatus = SAMPLE_STALE;
+    }
+    data = _lastData;
+    return (sample_status_t)_sampleStatus;
 }
 
 /*==============================================================================================================*
-    GET RAW DATA
+    COLLECT TRANSFER (MOVES A FINISHED ASYNCHRONOUS TRANSFER INTO THE RING BUFFER, ISR-SAFE)
  *==============================================================================================================*/
 
-unsigned int MCP3221::getRawData() {
-    unsigned int rawData = 0;
-    Wire.requestFrom(_devAddr, DATA_BYTES);
-    if (Wire.available() == DATA_BYTES) rawData = (Wire.read() << 8) | (Wire.read());
-    else ping();
-    return rawData;
+void MCP3221::collectTransfer() {
+    _asyncBusy = false;
+    byte received = _bus->available() / DATA_BYTES;
+    for (byte i=0; i<received; i++) {
+        uint16_t sample = _bus->read() << 8;
+        sample |= _bus->read();
+        _ring->push(sample);
+    }
+    _asyncReads++;                                                              // tallied for poll(), which
+    _asyncSamples += received;                                                  // may be interrupted by this
+    if (received < _asyncChunk) _asyncShortReads++;
+}
+
+/*==============================================================================================================*
+    RECORD TRANSFERS (FOLDS THE COLLECTED ASYNCHRONOUS TRANSFERS INTO THE I2C COMMUNICATION STATISTICS)
+ *==============================================================================================================*/
+
+// A split-phase transfer's duration isn't observable from either end, so the transfers are counted without
+// touching the read time figures.
+
+void MCP3221::recordTransfers() {
+    noInterrupts();
+    unsigned int reads = _asyncReads, samples = _asyncSamples, shortReads = _asyncShortReads;
+    _asyncReads = _asyncSamples = _asyncShortReads = 0;
+    interrupts();
+    if (!_comStats) return;
+    _comStats->reads += reads;
+    _comStats->samples += samples;
+    _comStats->shortReads += shortReads;
+}
+
+/*==============================================================================================================*
+    RECORD READ (UPDATES THE I2C COMMUNICATION STATISTICS)
+ *==============================================================================================================*/
+
+void MCP3221::recordRead(unsigned long time, byte received, byte requested) {
+    byte bin = 0;
+    _comStats->reads++;
+    _comStats->samples += received;
+    if (received < requested) _comStats->shortReads++;
+    _comStats->timedReads++;
+    if (time < _comStats->minTime) _comStats->minTime = time;
+    if (time > _comStats->maxTime) _comStats->maxTime = time;
+    _comStats->totalTime += time;
+    while ((time >>= 1) && (bin < (NUM_LATENCY_BINS - 1))) bin++;
+    _comStats->latency[bin]++;
+}
+
+/*==============================================================================================================*
+    FILTER DATA (PIPELINE STAGES FOLLOWED BY THE SELECTED SMOOTHING METHOD, FALSE = SAMPLE CONSUMED BY A STAGE)
+ *==============================================================================================================*/
+
+bool MCP3221::filterData(unsigned int &data) {
+    for (MCP3221Stage *stage = _stages; stage; stage = stage->_next) {
+        if (!stage->process(data)) return false;
+    }
+    data = smoothData(data);
+    return true;
+}
+
+/*==============================================================================================================*
+    FILTER BLOCK (IN PLACE, RETURNS THE NUMBER OF SAMPLES LEFT AFTER DECIMATING STAGES)
+ *==============================================================================================================*/
+
+// Each stage runs over the whole block before the next one starts, so the virtual call happens once per stage
+// per block rather than once per stage per sample, and each stage's inner loop keeps its state in registers.
+
+size_t MCP3221::filterBlock(uint16_t *samples, size_t count) {
+    for (MCP3221Stage *stage = _stages; stage && count; stage = stage->_next) count = stage->processBlock(samples, count);
+    if (_smoothing != NO_SMOOTHING) {
+        for (size_t i=0; i<count; i++) samples[i] = smoothData(samples[i]);
+    }
+    return count;
 }
 
 /*==============================================================================================================*
@@ -265,23 +808,97 @@ unsigned int MCP3221::getRawData() {
  *==============================================================================================================*/
 
 unsigned int MCP3221::smoothData(unsigned int rawData) {
-    unsigned int smoothedData;
-    if (_smoothing == EMAVG) {                                                  // Exmponential Moving Average
-        unsigned int emAvg = rawData;
-        emAvg = (_alpha * (unsigned long)rawData + (MAX_ALPHA - _alpha) * (unsigned long)emAvg) / MAX_ALPHA;
-        smoothedData = emAvg;
-    } else {                                                                    // Rolling-Average
-        unsigned long sum = 0;
-        if (_samples[_numSamples - 1] != 0) {
-            for (byte i = 1; i<_numSamples; i++) _samples[i - 1] = _samples[i]; // drop last reading & rearrange array
-            _samples[_numSamples - 1] = rawData;                                // add a new sample at the end of array
-            for (byte j=0; j<_numSamples; j++) sum += _samples[j];              // aggregate all samples
-            smoothedData = sum / _numSamples;                                   // calculate average
-        } else {
-            for (byte i = 0; i<_numSamples; i++) _samples[i] = rawData;
-            smoothedData = rawData;
-        }
+    switch (_smoothing) {
+        case (ROLLING_AVG): _window.push(_samples, rawData); return _window.average();
+        case (EMAVG):       return _ema.update(rawData);
+        case (MEDIAN):      _window.push(_samples, rawData); return _window.median(_samples);
+        default:            return rawData;
+    }
+}
+
+/*==============================================================================================================*
+    UPDATE VOLTAGE SCALE (PRECOMPUTES THE FIXED-POINT mV-PER-COUNT MULTIPLIER WHENEVER THE SETTINGS CHANGE)
+ *==============================================================================================================*/
+
+// 5V input:  mV = data * Vref / 4096            -> scale = Vref (12 fractional bits, exact)
+// 12V input: mV = data * (R1 + R2) / R2         -> scale = (R1 + R2) / R2 with up to 16 fractional bits,
+//                                                  reduced as needed so that MAX_CAL_CODE * scale still fits 32 bits
+
+void MCP3221::updateVoltageScale() {
+    if (_voltageInput == VOLTAGE_INPUT_5V) {
+        _vScale = _vRef;
+        _vShift = 12;
+    } else if (!_res2) {
+        _vScale = 0;
+        _vShift = 0;
+    } else {
+        unsigned long sum = (unsigned long)_res1 + _res2;
+        _vShift = VOLTAGE_SHIFT;
+        while (_vShift && ((sum >> (32 - _vShift)) || ((((sum << _vShift) + _res2 / 2) / _res2) >> 19))) _vShift--;
+        _vScale = ((sum << _vShift) + _res2 / 2) / _res2;
     }
-    return smoothedData;
+}
+
+/*==============================================================================================================*
+    TO VOLTAGE (CONVERTS DATA TO mV: ONE MULTIPLY & SHIFT, OR A TABLE LOOK-UP)
+ *==============================================================================================================*/
+
+unsigned int MCP3221::toVoltage(unsigned int data) {
+    if (_vLut) {
+        if (data > 4095) data = 4095;                                           // calibrated codes may exceed the table
+        if (_vLutFull) return pgm_read_word(&_vLut[data & 0x0FFF]);
+        byte index = data >> 4;
+        int low = pgm_read_word(&_vLut[index]);
+        int high = (index < 255) ? pgm_read_word(&_vLut[index + 1]) : (2 * low - (int)pgm_read_word(&_vLut[index - 1]));
+        return low + (((long)(high - low) * (data & 0x0F)) >> 4);
+    }
+    return ((unsigned long)data * _vScale + ((1UL << _vShift) >> 1)) >> _vShift;
+}
+
+/*==============================================================================================================*
+    CALIBRATE (PIECEWISE-LINEAR CORRECTION FROM THE CALIBRATION TABLE, FOR 12 + extraBits DATA)
+ *==============================================================================================================*/
+
+// One table look-up, one multiply and one shift: the segment is picked by the top 4 bits of the 12-bit code
+// and the remaining bits interpolate between its two knots. Uncalibrated readings go through the identity table
+// at the same cost.
+
+unsigned long MCP3221::calibrate(unsigned long data, byte extraBits) {
+    byte shift = CAL_KNOT_SHIFT + extraBits;
+    byte index = data >> shift;
+    long low = (long)_calTable[index] << extraBits;
+    long delta = (long)_calTable[index + 1] - _calTable[index];
+    long result = low + ((delta * (long)(data & ((1UL << shift) - 1)) + (1L << (CAL_KNOT_SHIFT - 1))) >> CAL_KNOT_SHIFT);
+    return (result > 0) ? result : 0;
+}
+
+/*==============================================================================================================*
+    MEDIAN (SORTS UP TO MAX_MEDIAN_WINDOW VALUES IN PLACE, RETURNS THE MIDDLE ONE)
+ *==============================================================================================================*/
+
+// Insertion sort: at most 36 compare & move steps for a 9-sample window, and far fewer when the window arrives
+// nearly sorted (a slowly changing signal), so the cost per sample stays bounded.
+
+unsigned int Mcp3221::MCP3221_median(uint16_t *values, byte count) {
+    for (byte i=1; i<count; i++) {
+        uint16_t value = values[i];
+        byte j = i;
+        for (; j && (values[j - 1] > value); j--) values[j] = values[j - 1];
+        values[j] = value;
+    }
+    return values[count / 2];
+}
+
+/*==============================================================================================================*
+    RESET FILTERS (EMPTIES THE ROLLING-AVERAGE / MEDIAN WINDOW & RESEEDS THE EMAVG ACCUMULATOR)
+ *==============================================================================================================*/
+
+void MCP3221::resetFilters() {
+    byte window = _numSamples;
+    if (_smoothing == MEDIAN) window = min(_numSamples | 1, MAX_MEDIAN_WINDOW);   // odd, MAX_MEDIAN_WINDOW at most
+    if (window > _samplesSize) window = _samplesSize;                           // limited by the sample buffer
+    if ((_smoothing == MEDIAN) && window && !(window & 1)) window--;
+    _window.reset(window);
+    _ema.reset();
 }
 
@@ -88,7 +88,7 @@
     VOLTAGE INPUT:                  5V   // direct measurment of voltage at AIN pin (hw setup without voltage divider)
     VOLTAGE DIVIDER RESISTOR 1:     0R   // value used when measuring voltage of up to 12V at AIN pin
     VOLTAGE DIVIDER RESISTOR 2:     0R   // value used when measuring voltage of up to 12V at AIN pin
-    NUMBER OF SAMPLES:              10   // used by Rolling-Average smoothing method (range: 1-20 Samples)
+    NUMBER OF SAMPLES:              10   // used by Rolling-Average smoothing method (range: 1-32 Samples)
     ALPHA                          178   // factor used by EMAVG smoothing method (range: 1-256)
 
  *===============================================================================================================*
@@ -129,13 +129,15 @@ __asm volatile ("nop");
 #ifndef MCP3221_h
 #define MCP3221_h
 
-#if !defined(ARDUINO_ARCH_AVR)
-#error “The MCP3221 library only supports AVR processors.”
+#if !defined(ARDUINO_ARCH_AVR) && !defined(MCP3221_HOST_BUILD) && !defined(EPOXY_DUINO)
+#error "The MCP3221 library only supports AVR processors (define MCP3221_HOST_BUILD for host-side builds)."
 #endif
 
 #include <Arduino.h>
 #include <Wire.h>
 #include "utility/MCP3221_PString.h"
+#include "utility/MCP3221_I2C.h"
+#include "utility/MCP3221_Ring.h"
 
 namespace Mcp3221 {
     
@@ -151,8 +153,38 @@ namespace Mcp3221 {
     const unsigned int MAX_ALPHA           =   256;     // maximum value of alpha (raw change/no filter) (for EMAVG)
     const unsigned int DEFAULT_ALPHA       =   178;     // default value of alpha (for EMAVG)
     const byte         MIN_NUM_SAMPLES     =     1;     // minimum number of samples (for Rolling-Average smoothing)
-    const byte         MAX_NUM_SAMPLES     =    20;     // maximum number of samples (for Rolling-Average smoothing)
+    const byte         MAX_NUM_SAMPLES     =    32;     // maximum number of samples (for Rolling-Average smoothing)
     const byte         DEFAULT_NUM_SAMPLES =    10;     // default number of samples (for Rolling-Average smoothing)
+    const byte         NO_SHIFT            =   255;     // marks a window / alpha value that isn't a power of two
+    const byte         MAX_MEDIAN_WINDOW   =     9;     // Median window limit (odd, sorted on every sample)
+    const byte         EMA_FRAC_BITS       =    16;     // fractional bits kept by the EMAVG accumulator
+    const byte         VOLTAGE_SHIFT       =    16;     // max fractional bits of the precomputed voltage scale
+    const unsigned int LUT_SIZE_256        =   256;     // voltage look-up table holding every 16th code
+    const unsigned int LUT_SIZE_4096       =  4096;     // voltage look-up table holding every code
+    const byte         MIN_EXTRA_BITS      =     1;     // oversampling: 4 samples for 13-bit results
+    const byte         MAX_EXTRA_BITS      =     4;     // oversampling: 256 samples for 16-bit results
+    const byte         OVERSAMPLING_CHUNK  =    16;     // samples read per I2C transaction when oversampling
+    const uint16_t     NO_OVERSAMPLED      = 0xFFFF;    // no valid oversampled result held yet (above 16-bit max)
+    const byte         DEFAULT_MAX_RETRIES =     2;     // repeated read attempts after a failed read
+    const unsigned int DEFAULT_RETRY_TIME  =  2000;     // time budget for a read including retries (in uS)
+    const byte         COM_BUS_ERROR       =     4;     // lowest I2C result code pointing to a stuck bus (4-5)
+    const byte         CAL_KNOTS           =    17;     // calibration table points (codes 0, 256 ... 4096)
+    const byte         CAL_KNOT_SHIFT      =     8;     // calibration table spacing (256 codes per segment)
+    const unsigned int MAX_CAL_CODE        =  8191;     // calibrated code limit (gain errors can push it past 4095)
+
+    const byte         NUM_COM_CODES       =     8;     // I2C result codes 0-6 plus 'unlisted error'
+    const byte         NUM_LATENCY_BINS    =    12;     // log2 transaction time histogram (<2uS ... >=2048uS)
+
+    typedef struct {
+        unsigned long reads;                            // read transactions
+        unsigned long samples;                          // samples received
+        unsigned int  shortReads;                       // reads returning fewer bytes than requested
+        unsigned int  comCodes[NUM_COM_CODES];          // ping() results by code (0 = success, 1-6, 7 = unlisted)
+        unsigned int  retries;                          // repeated read attempts
+        unsigned long timedReads;                       // reads with a known duration (split-phase ones have none)
+        unsigned long minTime, maxTime, totalTime;      // read transaction time (in uS, over the timed reads)
+        unsigned int  latency[NUM_LATENCY_BINS];        // bin n: transactions taking 2^n - 2^(n+1)-1 uS (bin 0: 0-1uS)
+    } mcp3221_com_stats_t;
 
     typedef enum:byte {
         VOLTAGE_INPUT_5V  = 0,  // default
@@ -162,9 +194,103 @@ namespace Mcp3221 {
     typedef enum:byte {
         NO_SMOOTHING = 0,
         ROLLING_AVG  = 1,
-        EMAVG        = 2     // Default
+        EMAVG        = 2,    // Default
+        MEDIAN       = 3
     } smoothing_t;
 
+    typedef enum:byte {
+        SAMPLE_VALID  = 0,   // fresh reading
+        SAMPLE_STALE  = 1,   // read failed, last valid reading held
+        SAMPLE_FAILED = 2    // read failed, no valid reading available yet
+    } sample_status_t;
+
+    typedef struct {
+        byte         devAddr;                           // I2C address
+        byte         comResult;                         // latest I2C communication result code (0 = success)
+        byte         voltageInput;                      // voltage_input_t
+        byte         smoothing;                         // smoothing_t
+        unsigned int vRef;                              // in mV
+        unsigned int res1, res2;                        // voltage divider resistors (in Ω)
+        unsigned int alpha;                             // EMAVG factor
+        byte         numSamples;                        // Rolling-Average window
+    } mcp3221_status_t;
+
+    unsigned int MCP3221_median(uint16_t *values, byte count);   // sorts values in place (insertion sort)
+
+/*==============================================================================================================*
+    FILTER CORES (SHARED BY THE BUILT-IN SMOOTHING METHODS & THE FILTER PIPELINE STAGES)
+ *==============================================================================================================*/
+
+    class MCP3221_WindowCore {                          // sliding window with running sum over caller's storage
+        public:
+            void reset(byte size) {
+                _size = size;
+                _index = _count = 0;
+                _sum = 0;
+                _shift = NO_SHIFT;
+                for (byte shift=0; (1 << shift) <= _size; shift++) {           // power-of-two windows divide by shift
+                    if ((1 << shift) == _size) _shift = shift;
+                }
+            }
+            void push(uint16_t *samples, unsigned int rawData) {
+                if (_count < _size) _count++;                                   // window still filling up
+                else _sum -= samples[_index];                                   // drop oldest sample from the sum
+                samples[_index] = rawData;                                      // overwrite oldest sample
+                _sum += rawData;
+                if (++_index >= _size) _index = 0;
+            }
+            unsigned int average() {
+                if (_count < _size) return _sum / _count;
+                return (_shift != NO_SHIFT) ? (_sum >> _shift) : (_sum / _size);
+            }
+            unsigned int median(const uint16_t *samples) {                      // window of MAX_MEDIAN_WINDOW at most
+                uint16_t sorted[MAX_MEDIAN_WINDOW];
+                for (byte i=0; i<_count; i++) sorted[i] = samples[i];
+                return MCP3221_median(sorted, _count);
+            }
+        private:
+            byte          _size, _index, _count, _shift;
+            unsigned long _sum;
+    };
+
+    class MCP3221_EmaCore {                             // exponential moving average with Q16 state
+        public:
+            void setAlpha(unsigned int alpha) {                                 // 1-256 (alpha/256 per sample)
+                _alpha = constrain(alpha, MIN_ALPHA, MAX_ALPHA);
+                _alphaShift = NO_SHIFT;
+                for (byte shift=0; (MAX_ALPHA >> shift) >= _alpha; shift++) {   // power-of-two alpha updates by shift
+                    if ((MAX_ALPHA >> shift) == _alpha) _alphaShift = shift;
+                }
+            }
+            unsigned int getAlpha() const {
+                return _alpha;
+            }
+            void reset() {
+                _primed = false;
+            }
+            unsigned int update(unsigned int rawData) {
+                long target = (long)rawData << EMA_FRAC_BITS;                   // accumulator keeps 16 fractional bits
+                if (!_primed) {
+                    _avg = target;                                              // first sample seeds the average
+                    _primed = true;
+                } else if (_alphaShift != NO_SHIFT) {
+                    _avg += (target - _avg) >> _alphaShift;                     // alpha = 256 / 2^n: shift & add only
+                } else {
+                    long delta = target - _avg;                                 // avg += alpha / 256 * (raw - avg)
+                    _avg += (delta >> 8) * (long)_alpha + (((delta & 0xFF) * _alpha) >> 8);   // split: stays in 32 bits
+                }
+                return (_avg + (1L << (EMA_FRAC_BITS - 1))) >> EMA_FRAC_BITS;
+            }
+        private:
+            long         _avg;
+            unsigned int _alpha;
+            byte         _alphaShift;
+            bool         _primed;
+    };
+
+    class MCP3221Stage;
+    class MCP3221Calibration;
+
     class MCP3221 {
         public:
             MCP3221(
@@ -187,24 +313,88 @@ namespace Mcp3221 {
             byte         getVinput();
             byte         getSmoothing();
             unsigned int getData();
+            sample_status_t readData(unsigned int &data);
+            sample_status_t readDataOnce(unsigned int &data);
+            sample_status_t getSampleStatus();
             unsigned int getVoltage();
+            unsigned int  getOversampled(byte extraBits);
+            sample_status_t readOversampled(byte extraBits, unsigned int &data);
+            unsigned long getOversampledVoltage(byte extraBits);
+            size_t       readBurst(uint16_t *dst, size_t numSamples);
+            void         startAsync(MCP3221_RingBase &ring, byte samplesPerTransfer = 1);
+            void         stopAsync();
+            void         poll();
+            void         onTransferComplete();
+            byte         available();
+            unsigned int read();
+            size_t       read(uint16_t *dst, size_t maxSamples);
             byte         getComResult();
+            void         getStatus(mcp3221_status_t &status);
+            MCP3221_I2C& getBus();
+            void         setComStats(mcp3221_com_stats_t *stats);
+            const mcp3221_com_stats_t& getComStats() const;
+            void         resetComStats();
             void         setVref(unsigned int newVref);
             void         setRes1(unsigned int newRes1);
             void         setRes2(unsigned int newRes2);
             void         setAlpha(unsigned int newAlpha);
             void         setNumSamples(byte newNumSamples);
+            void         setSampleBuffer(uint16_t *buffer, byte size);
             void         setVinput(voltage_input_t newVinput);
             void         setSmoothing(smoothing_t newSmoothing);
+            void         addStage(MCP3221Stage &stage);
+            void         clearStages();
+            void         setVoltageLUT(const uint16_t *lut, unsigned int lutSize);
+            void         setCalibration(const uint16_t *knots);
+            const uint16_t* getCalibration() const;
+            unsigned int calibrate(unsigned int data);
+            unsigned int voltageToData(unsigned int mV);
+            void         setBus(MCP3221_I2C& newBus);
+            void         setRetries(byte maxRetries, unsigned int retryTime = DEFAULT_RETRY_TIME);
+            byte         recoverBus();
             void         reset();
         private:
             byte         _devAddr, _voltageInput, _smoothing, _numSamples, _comBuffer;
-            unsigned int _vRef, _res1, _res2, _alpha;
-            unsigned int _samples[MAX_NUM_SAMPLES];
-            unsigned int getRawData();
+            MCP3221_WindowCore _window;
+            MCP3221_EmaCore _ema;
+            unsigned long _vScale;
+            byte         _vShift;
+            const uint16_t *_vLut;
+            bool         _vLutFull;
+            const uint16_t *_calTable;
+            unsigned int _vRef, _res1, _res2;
+            uint16_t    *_samples;                              // Rolling-Average / Median window
+            byte         _samplesSize;
+            uint16_t     _ownSamples[MAX_NUM_SAMPLES];          // default window storage
+            MCP3221_I2C* _bus;
+            mcp3221_com_stats_t *_comStats;
+            volatile unsigned int _asyncReads, _asyncSamples, _asyncShortReads;
+            MCP3221_RingBase *_ring;
+            MCP3221Stage *_stages;
+            byte         _asyncChunk;
+            volatile bool _asyncBusy;
+            byte         _maxRetries, _sampleStatus;
+            unsigned int _retryTime, _lastData;
+            uint16_t     _lastOversampled;                      // left-justified to 16 bits (MAX_EXTRA_BITS)
+            bool         readRawData(uint16_t *dst, byte numSamples);
+            bool         filterData(unsigned int &data);
+            size_t       filterBlock(uint16_t *samples, size_t count);
             unsigned int smoothData(unsigned int rawData);
-            friend       MCP3221_PString MCP3221ComStr(const MCP3221&);
-            friend       MCP3221_PString MCP3221InfoStr(const MCP3221&);
+            void         resetFilters();
+            void         updateVoltageScale();
+            unsigned int toVoltage(unsigned int data);
+            unsigned long calibrate(unsigned long data, byte extraBits);
+            byte         readSamples(uint16_t *dst, byte numSamples, bool pingOnFail = true);
+            sample_status_t storeData(bool success, uint16_t rawData, unsigned int &data);
+            void         collectTransfer();
+            void         recordRead(unsigned long time, byte received, byte requested);
+            void         recordTransfers();
+            friend       size_t MCP3221PrintComStatus(const MCP3221&, Print&);
+            friend       size_t MCP3221PrintComStats(const MCP3221&, Print&);
+            friend       size_t MCP3221PrintInfo(const MCP3221&, Print&);
+            friend class MCP3221Bus;
+            friend class MCP3221Calibration;
+            friend class MCP3221ClockTuner;
     };
 }
 
@@ -0,0 +1,93 @@
+/* 
+  MCP3221 LIBRARY - ASYNCHRONOUS ACQUISITION EXAMPLE
+  --------------------------------------------------
+
+  INTRODUCTION
+  ------------
+  This sketch shows how to decouple sampling from processing: the MCP3221 queues raw samples in a ring buffer
+  (acquired by poll() or, with an interrupt-driven I2C bus, from the bus's completion ISR) and the application
+  drains them in batches with read(), which is also where the selected smoothing method is applied.
+
+  Note that the standard 'Wire' library completes each transfer before returning, so with it poll() still performs
+  the transfer itself; an interrupt-driven MCP3221_I2C implementation (startRequest() / requestPending() overridden,
+  onTransferComplete() called from its ISR) removes the transfer time from the main loop altogether.
+
+  WIRING DIAGRAM
+  --------------
+                                       MCP3221
+                                       -------
+                                VCC --| •     |-- SCL
+                                      |       |
+                                GND --|       |
+                                      |       |
+                                AIN --|       |-- SDA
+                                       -------
+
+  PIN 1 (VCC/VREF) - Serves as both Power Supply input and Voltage Reference for the ADC. Connect to Arduino 5V output or any other
+                equivalent power source (5.5V max). If using an external power source, remember to connect all GND's together
+  PIN 2 (GND) - connect to Arduino GND
+  PIN 3 (AIN) - Connect to Arduino's 3.3V Output
+  PIN 4 (SDA) - Connect to Arduino's PIN A4 with a 2K2 (400MHz I2C Bus speed) or 10K (100MHz I2C Bus speed) pull-up resistor
+  PIN 5 (SCL) - Connect to Arduino's PIN A5 with a 2K2 (400MHz I2C Bus speed) or 10K (100MHz I2C Bus speed) pull-up resistor
+  DECOUPING:    Minimal decoupling consists of a 0.1uF Ceramic Capacitor between the VCC & GND PINS. For improved performance,
+                add a 1uF and a 10uF Ceramic Capacitors as well across these pins
+
+  BUG REPORTS
+  -----------
+  Please report any bugs/issues/suggestions at the GITHUB Repository of this library at: https://github.com/nadavmatalon/MCP3221
+
+  LICENSE
+  -------
+
+  The MIT License (MIT)
+  Copyright (c) 2016 Nadav Matalon
+  
+  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+  documentation files (the "Software"), to deal in the Software without restriction, including without
+  limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+  the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+  conditions:
+  
+  The above copyright notice and this permission notice shall be included in all copies or substantial
+  portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MCP3221.h"
+
+const byte          DEV_ADDR   = 0x4D;                // I2C address of the MCP3221 (Change as needed)
+const byte          BATCH_SIZE = 8;                   // number of samples processed at a time
+const unsigned long PRINT_MS   = 500;                 // printing interval
+
+MCP3221 mcp3221(DEV_ADDR);
+MCP3221_Ring<32> ring;                                // holds up to 31 raw samples
+
+uint16_t batch[BATCH_SIZE];
+unsigned long lastPrint;
+
+void setup() {
+    Serial.begin(9600);
+    Wire.begin();
+    while(!Serial);
+    mcp3221.startAsync(ring, 4);                      // 4 samples per I2C transaction
+}
+
+void loop() {
+    mcp3221.poll();
+    if (mcp3221.available() >= BATCH_SIZE) {
+        size_t numRead = mcp3221.read(batch, BATCH_SIZE);
+        if (millis() - lastPrint >= PRINT_MS) {
+            lastPrint = millis();
+            Serial.print(F("Data: "));
+            Serial.print(batch[numRead - 1]);
+            Serial.print(F("\tOverruns: "));
+            Serial.print(ring.getOverruns());
+            Serial.print(F("\n"));
+        }
+    }
+}
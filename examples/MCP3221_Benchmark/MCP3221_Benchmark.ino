@@ -0,0 +1,206 @@
+/* 
+  MCP3221 LIBRARY - BENCHMARK EXAMPLE
+  -----------------------------------
+
+  INTRODUCTION
+  ------------
+  This sketch measures the hot-path cost of the MCP3221 Library: reads per second (single & burst reads), CPU cycles
+  spent per smoothing step (Rolling-Average, EMAVG & Median), per filter pipeline pass (per-sample vs block processing)
+  and per voltage conversion (fixed-point scale & look-up table), and RAM used by each MCP3221 instance. Flash usage is reported by the IDE / compiler at the end of the build;
+  comment out the setVoltageLUT() calls to see the cost of the 512-byte table in 'VoltageLUT.h'.
+
+  By default the sketch runs against the simulated MCP3221 found in '/utility/MCP3221_SimI2C.h', so no hardware is
+  required and the figures reflect the library's own overhead only. Set USE_SIMULATOR to 'false' to benchmark a real
+  device on the I2C bus instead (see the hook-up notes of the other example sketches).
+
+  The simulator can also inject NACKs, short reads and clock-stretch latency, which makes it possible to exercise the
+  library's error paths on the bench.
+
+  HOST BUILDS
+  -----------
+  The library (and this sketch) can be compiled on a Linux/macOS host by defining MCP3221_HOST_BUILD (or by using the
+  EpoxyDuino Arduino emulation, which is detected automatically). In that case the simulator replaces the I2C bus and
+  the cycle figures are derived from F_CPU of the emulated board. '/extras/host' builds & runs it with CMake.
+
+  BUG REPORTS
+  -----------
+  Please report any bugs/issues/suggestions at the GITHUB Repository of this library at: https://github.com/nadavmatalon/MCP3221
+
+  LICENSE
+  -------
+
+  The MIT License (MIT)
+  Copyright (c) 2016 Nadav Matalon
+  
+  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+  documentation files (the "Software"), to deal in the Software without restriction, including without
+  limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+  the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+  conditions:
+  
+  The above copyright notice and this permission notice shall be included in all copies or substantial
+  portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MCP3221.h"
+#include "utility/MCP3221_SimI2C.h"
+#include "utility/MCP3221Filters.h"
+#include "VoltageLUT.h"                               // 256-entry table for a 12V input with a 10K/4K7 divider
+
+const byte         DEV_ADDR        = 0x4D;            // I2C address of the MCP3221 (Change as needed)
+const bool         USE_SIMULATOR   = true;            // set to 'false' to benchmark a real device
+const unsigned int NUM_READS       = 1000;            // number of readings per measurement
+const byte         BURST_SIZE      = 64;              // number of samples per readBurst() call
+const unsigned int NUM_BURSTS      = (NUM_READS + BURST_SIZE - 1) / BURST_SIZE;
+const unsigned int NUM_BURST_READS = NUM_BURSTS * BURST_SIZE;   // readings per burst / block measurement (1024)
+
+MCP3221_SimI2C sim(DEV_ADDR);                         // simulated MCP3221 (replaces the I2C bus)
+MCP3221 mcp3221(DEV_ADDR);
+
+volatile unsigned int sink;                           // keeps the compiler from discarding the readings
+uint16_t burstBuffer[BURST_SIZE];
+
+MCP3221Median<3>     medianStage;                     // filter pipeline used for the per-sample vs block comparison
+MCP3221RollingAvg<8> averageStage;
+MCP3221Ema           emaStage(64);
+MCP3221Stage        *pipeline[] = { &medianStage, &averageStage, &emaStage };
+const byte           NUM_STAGES = sizeof(pipeline) / sizeof(pipeline[0]);
+
+void runBenchmarks();                                 // prototypes (added by the Arduino IDE, but not by host builds)
+unsigned long timeReads(smoothing_t smoothingMethod);
+unsigned long timeBurstReads();
+unsigned long timeVoltageReads();
+void benchSmoothing(const __FlashStringHelper *name, smoothing_t smoothingMethod, unsigned long rawTime);
+unsigned long timePipeline(bool blockMode);
+void benchPipeline();
+void benchVoltage();
+void printResult(const __FlashStringHelper *name, unsigned long time, unsigned long rawTime,
+                 unsigned int numReads = NUM_READS);
+void printDivider();
+
+void setup() {
+    Serial.begin(9600);
+    Wire.begin();
+    while(!Serial);
+    if (USE_SIMULATOR) {
+        sim.setWaveform(SIM_SINE, 2048, 1500, 250);
+        sim.setNoise(8);
+        mcp3221.setBus(sim);
+    }
+    runBenchmarks();
+}
+
+void loop() {}
+
+void runBenchmarks() {
+    printDivider();
+    Serial.print(F("\nMCP3221 BENCHMARK ("));
+    Serial.print(USE_SIMULATOR ? F("SIMULATED DEVICE") : F("I2C DEVICE"));
+    Serial.print(F(")\n"));
+    printDivider();
+    Serial.print(F("\nRAM PER INSTANCE:\t"));
+    Serial.print(sizeof(MCP3221));
+    Serial.print(F(" BYTES\n"));
+    unsigned long rawTime = timeReads(NO_SMOOTHING);
+    Serial.print(F("\nREADS PER SECOND:\t"));
+    Serial.print(NUM_READS * 1000000UL / rawTime);
+    Serial.print(F("\n"));
+    Serial.print(F("\nBURST READS PER SECOND:\t"));
+    Serial.print(NUM_BURST_READS * 1000000UL / timeBurstReads());
+    Serial.print(F("\n"));
+    benchSmoothing(F("ROLLING-AVERAGE"), ROLLING_AVG, rawTime);
+    benchSmoothing(F("EMAVG"), EMAVG, rawTime);
+    benchSmoothing(F("MEDIAN"), MEDIAN, rawTime);
+    benchPipeline();
+    benchVoltage();
+    printDivider();
+}
+
+unsigned long timeReads(smoothing_t smoothingMethod) {
+    mcp3221.setSmoothing(smoothingMethod);
+    unsigned long start = micros();
+    for (unsigned int i=0; i<NUM_READS; i++) sink = mcp3221.getData();
+    unsigned long elapsed = micros() - start;
+    return elapsed ? elapsed : 1;
+}
+
+unsigned long timeBurstReads() {
+    mcp3221.setSmoothing(NO_SMOOTHING);
+    unsigned long start = micros();
+    for (unsigned int i=0; i<NUM_BURSTS; i++) sink = mcp3221.readBurst(burstBuffer, BURST_SIZE);
+    unsigned long elapsed = micros() - start;
+    return elapsed ? elapsed : 1;
+}
+
+unsigned long timeVoltageReads() {
+    unsigned long start = micros();
+    for (unsigned int i=0; i<NUM_READS; i++) sink = mcp3221.getVoltage();
+    unsigned long elapsed = micros() - start;
+    return elapsed ? elapsed : 1;
+}
+
+void benchSmoothing(const __FlashStringHelper *name, smoothing_t smoothingMethod, unsigned long rawTime) {
+    printResult(name, timeReads(smoothingMethod), rawTime);
+}
+
+unsigned long timePipeline(bool blockMode) {
+    unsigned long start = micros();
+    for (unsigned int i=0; i<NUM_BURST_READS; i+=BURST_SIZE) {
+        for (byte j=0; j<BURST_SIZE; j++) burstBuffer[j] = 2048 + ((i + j) & 0x3F);
+        if (blockMode) {
+            size_t count = BURST_SIZE;
+            for (byte stage=0; stage<NUM_STAGES; stage++) count = pipeline[stage]->processBlock(burstBuffer, count);
+        } else {
+            for (byte j=0; j<BURST_SIZE; j++) {
+                unsigned int sample = burstBuffer[j];
+                for (byte stage=0; stage<NUM_STAGES; stage++) pipeline[stage]->process(sample);
+                burstBuffer[j] = sample;
+            }
+        }
+        sink = burstBuffer[BURST_SIZE - 1];
+    }
+    unsigned long elapsed = micros() - start;
+    return elapsed ? elapsed : 1;
+}
+
+void benchPipeline() {
+    unsigned long start = micros();                                 // cost of refilling the buffer alone
+    for (unsigned int i=0; i<NUM_BURST_READS; i+=BURST_SIZE) {
+        for (byte j=0; j<BURST_SIZE; j++) burstBuffer[j] = 2048 + ((i + j) & 0x3F);
+        sink = burstBuffer[BURST_SIZE - 1];
+    }
+    unsigned long fillTime = micros() - start;
+    printResult(F("PIPELINE (PER-SAMPLE, 3 STAGES)"), timePipeline(false), fillTime, NUM_BURST_READS);
+    printResult(F("PIPELINE (BLOCK, 3 STAGES)"), timePipeline(true), fillTime, NUM_BURST_READS);
+}
+
+void benchVoltage() {
+    mcp3221.setVinput(VOLTAGE_INPUT_12V);
+    unsigned long rawTime = timeReads(NO_SMOOTHING);
+    printResult(F("VOLTAGE (FIXED-POINT)"), timeVoltageReads(), rawTime);
+    mcp3221.setVoltageLUT(VOLTAGE_LUT, LUT_SIZE_256);
+    printResult(F("VOLTAGE (256-ENTRY LUT)"), timeVoltageReads(), rawTime);
+    mcp3221.setVoltageLUT(NULL, 0);
+    mcp3221.setVinput(VOLTAGE_INPUT_5V);
+}
+
+void printResult(const __FlashStringHelper *name, unsigned long time, unsigned long rawTime, unsigned int numReads) {
+    unsigned long extraTime = (time > rawTime) ? (time - rawTime) : 0;
+    Serial.print(F("\n"));
+    Serial.print(name);
+    Serial.print(F(":\n  CYCLES PER SAMPLE:\t"));
+    Serial.print(extraTime * (F_CPU / 1000000UL) / numReads);
+    Serial.print(F("\n  READS PER SECOND:\t"));
+    Serial.print(numReads * 1000000UL / time);
+    Serial.print(F("\n"));
+}
+
+void printDivider() {
+    Serial.print(F("\n--------------------------------\n"));
+}
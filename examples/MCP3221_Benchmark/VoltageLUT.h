@@ -0,0 +1,21 @@
+// Generated by MCP3221_LUTGen.py: --vref 4096 --vinput 12 --res1 10000 --res2 4700 --size 256
+// Usage: mcp3221.setVoltageLUT(VOLTAGE_LUT, 256);
+
+const uint16_t VOLTAGE_LUT[256] PROGMEM = {
+        0,    50,   100,   150,   200,   250,   300,   350,   400,   450,   500,   550,   601,   651,   701,   751,
+      801,   851,   901,   951,  1001,  1051,  1101,  1151,  1201,  1251,  1301,  1351,  1401,  1451,  1501,  1551,
+     1601,  1651,  1701,  1751,  1802,  1852,  1902,  1952,  2002,  2052,  2102,  2152,  2202,  2252,  2302,  2352,
+     2402,  2452,  2502,  2552,  2602,  2652,  2702,  2752,  2802,  2852,  2902,  2953,  3003,  3053,  3103,  3153,
+     3203,  3253,  3303,  3353,  3403,  3453,  3503,  3553,  3603,  3653,  3703,  3753,  3803,  3853,  3903,  3953,
+     4003,  4053,  4103,  4154,  4204,  4254,  4304,  4354,  4404,  4454,  4504,  4554,  4604,  4654,  4704,  4754,
+     4804,  4854,  4904,  4954,  5004,  5054,  5104,  5154,  5204,  5254,  5305,  5355,  5405,  5455,  5505,  5555,
+     5605,  5655,  5705,  5755,  5805,  5855,  5905,  5955,  6005,  6055,  6105,  6155,  6205,  6255,  6305,  6355,
+     6405,  6455,  6506,  6556,  6606,  6656,  6706,  6756,  6806,  6856,  6906,  6956,  7006,  7056,  7106,  7156,
+     7206,  7256,  7306,  7356,  7406,  7456,  7506,  7556,  7606,  7657,  7707,  7757,  7807,  7857,  7907,  7957,
+     8007,  8057,  8107,  8157,  8207,  8257,  8307,  8357,  8407,  8457,  8507,  8557,  8607,  8657,  8707,  8757,
+     8807,  8858,  8908,  8958,  9008,  9058,  9108,  9158,  9208,  9258,  9308,  9358,  9408,  9458,  9508,  9558,
+     9608,  9658,  9708,  9758,  9808,  9858,  9908,  9958, 10009, 10059, 10109, 10159, 10209, 10259, 10309, 10359,
+    10409, 10459, 10509, 10559, 10609, 10659, 10709, 10759, 10809, 10859, 10909, 10959, 11009, 11059, 11109, 11159,
+    11210, 11260, 11310, 11360, 11410, 11460, 11510, 11560, 11610, 11660, 11710, 11760, 11810, 11860, 11910, 11960,
+    12010, 12060, 12110, 12160, 12210, 12260, 12310, 12361, 12411, 12461, 12511, 12561, 12611, 12661, 12711, 12761
+};
@@ -0,0 +1,86 @@
+/* 
+  MCP3221 LIBRARY - BINARY LOG EXAMPLE
+  ------------------------------------
+
+  INTRODUCTION
+  ------------
+  This sketch streams readings over Serial in the compact binary log format (see '/utility/MCP3221Log.h') instead
+  of decimal text: 12-bit samples packed two per 3 bytes, or delta/varint encoded (usually 1 byte per sample for
+  slowly changing signals), with a sync header carrying the device address and a timestamp every 64 samples.
+  Samples are taken at a fixed rate by MCP3221Sampler.
+
+  The Serial output is binary, so capture it to a file (rather than viewing it in the Serial Monitor) and convert
+  it to CSV with the host-side decoder in '/extras/tools':
+
+      g++ -O2 -o MCP3221LogDecode MCP3221LogDecode.cpp
+      ./MCP3221LogDecode capture.bin > capture.csv
+
+  WIRING DIAGRAM
+  --------------
+                                       MCP3221
+                                       -------
+                                VCC --| •     |-- SCL
+                                      |       |
+                                GND --|       |
+                                      |       |
+                                AIN --|       |-- SDA
+                                       -------
+
+  PIN 1 (VCC/VREF) - Serves as both Power Supply input and Voltage Reference for the ADC. Connect to Arduino 5V output or any other
+                equivalent power source (5.5V max). If using an external power source, remember to connect all GND's together
+  PIN 2 (GND) - connect to Arduino GND
+  PIN 3 (AIN) - Connect to Arduino's 3.3V Output
+  PIN 4 (SDA) - Connect to Arduino's PIN A4 with a 2K2 (400MHz I2C Bus speed) or 10K (100MHz I2C Bus speed) pull-up resistor
+  PIN 5 (SCL) - Connect to Arduino's PIN A5 with a 2K2 (400MHz I2C Bus speed) or 10K (100MHz I2C Bus speed) pull-up resistor
+  DECOUPING:    Minimal decoupling consists of a 0.1uF Ceramic Capacitor between the VCC & GND PINS. For improved performance,
+                add a 1uF and a 10uF Ceramic Capacitors as well across these pins
+
+  BUG REPORTS
+  -----------
+  Please report any bugs/issues/suggestions at the GITHUB Repository of this library at: https://github.com/nadavmatalon/MCP3221
+
+  LICENSE
+  -------
+
+  The MIT License (MIT)
+  Copyright (c) 2016 Nadav Matalon
+  
+  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+  documentation files (the "Software"), to deal in the Software without restriction, including without
+  limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+  the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+  conditions:
+  
+  The above copyright notice and this permission notice shall be included in all copies or substantial
+  portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MCP3221.h"
+#include "utility/MCP3221Sampler.h"
+#include "utility/MCP3221Log.h"
+
+const byte          DEV_ADDR    = 0x4D;               // I2C address of the MCP3221 (Change as needed)
+const unsigned long SAMPLE_RATE = 500;                // samples per second
+
+MCP3221 mcp3221(DEV_ADDR);
+MCP3221Sampler sampler(mcp3221, SAMPLE_RATE);
+MCP3221LogEncoder<Print> logger(Serial, DEV_ADDR, LOG_DELTA);
+
+void setup() {
+    Serial.begin(115200);
+    Wire.begin();
+    while(!Serial);
+    mcp3221.setSmoothing(NO_SMOOTHING);
+    sampler.begin();
+}
+
+void loop() {
+    mcp3221_sample_t sample;
+    if (sampler.poll(sample)) logger.write(sample.value, sample.timestamp);
+}
@@ -0,0 +1,115 @@
+/* 
+  MCP3221 LIBRARY - CALIBRATION EXAMPLE
+  -------------------------------------
+
+  INTRODUCTION
+  ------------
+  This sketch calibrates the MCP3221's voltage readings against an accurate meter and keeps the calibration in
+  EEPROM, so it is applied automatically on the next start-up (see MCP3221Calibration in the README).
+
+  Apply a stable voltage to the input, measure it with the meter, and send the measured value in mV over the
+  Serial Monitor (e.g. '1250'). Repeat for two or more voltages spread over the input range (one near each end
+  corrects offset & gain; points in between also correct non-linearity). Then send:
+
+      'a' - apply the points entered so far       's' - apply & save them to EEPROM
+      'c' - clear the points & the calibration    'e' - erase the EEPROM slot
+
+  The current (calibrated) reading is printed once per second.
+
+  WIRING DIAGRAM
+  --------------
+                                       MCP3221
+                                       -------
+                                VCC --| •     |-- SCL
+                                      |       |
+                                GND --|       |
+                                      |       |
+                                AIN --|       |-- SDA
+                                       -------
+
+  PIN 1 (VCC/VREF) - Serves as both Power Supply input and Voltage Reference for the ADC. Connect to Arduino 5V output or any other
+                equivalent power source (5.5V max). If using an external power source, remember to connect all GND's together
+  PIN 2 (GND) - connect to Arduino GND
+  PIN 3 (AIN) - Connect to the voltage to be measured (0 - VREF)
+  PIN 4 (SDA) - Connect to Arduino's PIN A4 with a 2K2 (400MHz I2C Bus speed) or 10K (100MHz I2C Bus speed) pull-up resistor
+  PIN 5 (SCL) - Connect to Arduino's PIN A5 with a 2K2 (400MHz I2C Bus speed) or 10K (100MHz I2C Bus speed) pull-up resistor
+  DECOUPING:    Minimal decoupling consists of a 0.1uF Ceramic Capacitor between the VCC & GND PINS. For improved performance,
+                add a 1uF and a 10uF Ceramic Capacitors as well across these pins
+
+  BUG REPORTS
+  -----------
+  Please report any bugs/issues/suggestions at the GITHUB Repository of this library at: https://github.com/nadavmatalon/MCP3221
+
+  LICENSE
+  -------
+
+  The MIT License (MIT)
+  Copyright (c) 2016 Nadav Matalon
+  
+  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+  documentation files (the "Software"), to deal in the Software without restriction, including without
+  limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+  the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+  conditions:
+  
+  The above copyright notice and this permission notice shall be included in all copies or substantial
+  portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MCP3221.h"
+#include "utility/MCP3221Calibration.h"
+
+const byte         DEV_ADDR = 0x4D;                   // I2C address of the MCP3221 (Change as needed)
+const unsigned int VREF     = 5000;                   // nominal voltage reference in mV (Change as needed)
+
+MCP3221 mcp3221(DEV_ADDR, VREF);
+MCP3221Calibration calibration(mcp3221);
+
+unsigned int  entry = 0;
+unsigned long lastPrint = 0;
+
+void setup() {
+    Serial.begin(9600);
+    Wire.begin();
+    while(!Serial);
+    Serial.print(calibration.load() ? F("\nCalibration loaded (") : F("\nNo stored calibration ("));
+    Serial.print(calibration.getNumPoints());
+    Serial.print(F(" points)\n"));
+}
+
+void loop() {
+    while (Serial.available()) handleInput(Serial.read());
+    if (millis() - lastPrint >= 1000) {
+        lastPrint = millis();
+        Serial.print(F("\nVoltage: "));
+        Serial.print(mcp3221.getVoltage());
+        Serial.print(F("mV"));
+    }
+}
+
+void handleInput(char c) {
+    if ((c >= '0') && (c <= '9')) {
+        entry = entry * 10 + (c - '0');
+    } else if ((c == '\n') && entry) {
+        Serial.print(calibration.addPoint(entry) ? F("\nPoint added: ") : F("\nPoint NOT added: "));
+        Serial.print(entry);
+        Serial.print(F("mV"));
+        entry = 0;
+    } else if (c == 'a') {
+        Serial.print(calibration.apply() ? F("\nCalibration applied") : F("\nNo points entered"));
+    } else if (c == 's') {
+        Serial.print((calibration.apply() && calibration.save()) ? F("\nCalibration saved") : F("\nNo points entered"));
+    } else if (c == 'c') {
+        calibration.clear();
+        Serial.print(F("\nCalibration cleared"));
+    } else if (c == 'e') {
+        calibration.erase();
+        Serial.print(F("\nEEPROM slot erased"));
+    }
+}
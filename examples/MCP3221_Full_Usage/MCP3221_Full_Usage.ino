@@ -137,6 +137,7 @@ void testGetSmoothingMethod() {
         case (0): Serial.print(F("NO SMOOTHING\n")); break;
         case (1): Serial.print(F("ROLLING-AVERAGE\n")); break;
         case (2): Serial.print(F("EMAVG\n")); break;
+        case (3): Serial.print(F("MEDIAN\n")); break;
     }
 }
 
@@ -193,13 +194,14 @@ void testSetVoltageReference() {
 }
 
 void testSetSmoothingMethod() {
-    smoothing_t smoothingMethods[3] = { NO_SMOOTHING, ROLLING_AVG, EMAVG };
-    for (byte i=0; i<3; i++) {
+    smoothing_t smoothingMethods[4] = { NO_SMOOTHING, ROLLING_AVG, EMAVG, MEDIAN };
+    for (byte i=0; i<4; i++) {
         Serial.print(F("\nSetting Smoothing Method to "));
         switch (i) {
             case (0): Serial.print(F("NO SMOOTHING")); break;
             case (1): Serial.print(F("ROLLING-AVERAGE")); break;
             case (2): Serial.print(F("EMAVG")); break;
+            case (3): Serial.print(F("MEDIAN")); break;
         }  
         mcp3221.setSmoothing(smoothingMethods[i]);
         Serial.print(F(" ... DONE\n"));
@@ -258,7 +260,7 @@ void testSetAlpha() {
 }
 
 void testSetNumSamples() {
-    byte numSamplesParams[4] = { 18, 0, 21, DEFAULT_NUM_SAMPLES };
+    byte numSamplesParams[4] = { 18, 0, 33, DEFAULT_NUM_SAMPLES };
     for (byte i=0; i<4; i++) {
         Serial.print(F("\nSetting Number of Samples to "));
         Serial.print(numSamplesParams[i]);
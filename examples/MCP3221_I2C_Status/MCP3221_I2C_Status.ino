@@ -13,6 +13,10 @@
   Note that this functional extension does come at the cost of an increased memory usage, and therefore it seemed preferable to maintain it 
   as an optional add-on rather than include it in the core MCP3221 Library itself.
 
+  The text is streamed straight from PROGMEM to Serial (or any other Print object). If it is needed in memory instead,
+  MCP3221ComStr(mcp3221, buffer, COM_BUFFER_SIZE) writes it into a char buffer provided by the sketch, and
+  MCP3221ComStr(mcp3221) into a static buffer of the library.
+
   WIRING DIAGRAM
   --------------
                                        MCP3221
@@ -90,7 +94,7 @@ void setup() {
     Serial.print(F("\n\nVOLTAGE READING:\t"));
     Serial.print(mcp3221.getVoltage());
     Serial.print(F("\n\nI2C STATUS:\t"));
-    Serial.print(MCP3221ComStr(mcp3221));
+    MCP3221PrintComStatus(mcp3221, Serial);
     Serial.print(F("\n\n"));
 }
 
@@ -12,6 +12,10 @@
   
   Note that this functional extension does come at the cost of an increased memory usage, and therefore it seemed preferable to maintain it 
   as an optional add-on rather than include it in the core MCP3221 Library itself.
+
+  The text is streamed straight from PROGMEM to Serial (or any other Print object). If it is needed in memory instead,
+  MCP3221InfoStr(mcp3221, buffer, INFO_BUFFER_SIZE) writes it into a char buffer provided by the sketch, and
+  MCP3221InfoStr(mcp3221) into a static buffer of the library.
   
   WIRING DIAGRAM
   --------------
@@ -87,7 +91,7 @@ void setup() {
     Wire.begin();
     while(!Serial);
     Serial.print(F("\n\nCURRENT SETTINGS:\n"));
-    Serial.print(MCP3221InfoStr(mcp3221));
+    MCP3221PrintInfo(mcp3221, Serial);
     Serial.print(F("\nCHANGING TO NEW SETTINGS..."));
     mcp3221.setVref(5112);
     mcp3221.setSmoothing(ROLLING_AVG);
@@ -97,11 +101,11 @@ void setup() {
     mcp3221.setAlpha(134);
     mcp3221.setNumSamples(16);
     Serial.print(F("DONE\n"));
-    Serial.print(MCP3221InfoStr(mcp3221));
+    MCP3221PrintInfo(mcp3221, Serial);
     Serial.print(F("\nRESETTING DEVICE..."));
     mcp3221.reset();
     Serial.print(F("DONE\n"));
-    Serial.print(MCP3221InfoStr(mcp3221));
+    MCP3221PrintInfo(mcp3221, Serial);
     Serial.print(F("\n\n"));
 }
 
@@ -0,0 +1,121 @@
+/*==============================================================================================================*
+
+    @file     Arduino.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+#include <time.h>
+#include <stdio.h>
+#include "Arduino.h"
+#include "Wire.h"
+#include "EEPROM.h"
+
+HardwareSerial Serial;
+TwoWire        Wire;
+EEPROMClass    EEPROM;
+
+static bool          simulated = false;
+static unsigned long simTime   = 0;                     // simulated clock (in uS)
+
+/*==============================================================================================================*
+    HOST CLOCK (MONOTONIC, FROM THE FIRST CALL)
+ *==============================================================================================================*/
+
+static unsigned long hostMicros() {
+    static struct timespec start;
+    static bool started = false;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (!started) {
+        start = now;
+        started = true;
+    }
+    return (unsigned long)(now.tv_sec - start.tv_sec) * 1000000UL + (now.tv_nsec - start.tv_nsec) / 1000L;
+}
+
+/*==============================================================================================================*
+    TIME
+ *==============================================================================================================*/
+
+unsigned long micros() {
+    return simulated ? ++simTime : hostMicros();
+}
+
+unsigned long millis() {
+    return micros() / 1000UL;
+}
+
+void delay(unsigned long ms) {
+    while (ms--) delayMicroseconds(1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    if (simulated) {
+        simTime += us;
+        return;
+    }
+    struct timespec wait = { 0, (long)us * 1000L };
+    nanosleep(&wait, NULL);
+}
+
+/*==============================================================================================================*
+    SIMULATED CLOCK (HOST BUILDS ONLY)
+ *==============================================================================================================*/
+
+void setSimulatedClock(bool on) {
+    simulated = on;
+    simTime = 0;
+}
+
+void advanceClock(unsigned long us) {
+    simTime += us;
+}
+
+/*==============================================================================================================*
+    DIGITAL PINS (NOTHING ATTACHED: INPUTS READ HIGH, AS WITH RELEASED I2C LINES)
+ *==============================================================================================================*/
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t, uint8_t) {}
+
+int digitalRead(uint8_t) {
+    return HIGH;
+}
+
+/*==============================================================================================================*
+    SERIAL (STDOUT)
+ *==============================================================================================================*/
+
+size_t HardwareSerial::write(uint8_t data) {
+    return (putchar(data) == EOF) ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/*==============================================================================================================*
+
+    @file     Arduino.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    MINIMAL ARDUINO CORE FOR HOST BUILDS (ONLY WHAT THE LIBRARY, ITS TESTS & THE BENCHMARK SKETCH USE)
+ *==============================================================================================================*
+
+    Stands in for the AVR core when the library is compiled on a Linux/macOS host (see '/extras/host').
+    Interrupt masking is a no-op and Serial writes to stdout. Time is taken from the host's monotonic clock,
+    unless a test switches to the simulated clock, which only moves when delay() / delayMicroseconds() or
+    advanceClock() are called (and by 1uS per micros() / millis() call, so busy-wait loops still end).
+
+ *==============================================================================================================*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+#include "Print.h"
+
+#define HIGH         0x1
+#define LOW          0x0
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#ifndef F_CPU
+#define F_CPU 16000000UL                                // cycle figures are reported for a 16MHz board
+#endif
+
+#define SDA 18
+#define SCL 19
+
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define abs(x) ((x)>0?(x):-(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+
+#define interrupts()
+#define noInterrupts()
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+unsigned long micros();
+unsigned long millis();
+void          delay(unsigned long ms);
+void          delayMicroseconds(unsigned int us);
+void          pinMode(uint8_t pin, uint8_t mode);
+void          digitalWrite(uint8_t pin, uint8_t value);
+int           digitalRead(uint8_t pin);
+
+void          setSimulatedClock(bool simulated);          // host builds only: see above
+void          advanceClock(unsigned long us);
+
+class HardwareSerial : public Print {
+    public:
+        void   begin(unsigned long) {}
+        int    available() { return 0; }
+        int    read() { return -1; }
+        size_t write(uint8_t data);
+        operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
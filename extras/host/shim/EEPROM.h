@@ -0,0 +1,71 @@
+/*==============================================================================================================*
+
+    @file     EEPROM.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    MINIMAL EEPROM LIBRARY FOR HOST BUILDS (1KB IN RAM, ERASED TO 0xFF AT START-UP, AS ON AN ATmega328P)
+ *==============================================================================================================*/
+
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include <stdint.h>
+#include <string.h>
+
+const uint16_t HOST_EEPROM_SIZE = 1024;
+
+class EEPROMClass {
+    public:
+        EEPROMClass() {
+            memset(_data, 0xFF, sizeof(_data));
+        }
+        uint8_t  read(int idx) { return _data[idx]; }
+        void     write(int idx, uint8_t val) { _data[idx] = val; }
+        void     update(int idx, uint8_t val) { _data[idx] = val; }
+        uint16_t length() { return HOST_EEPROM_SIZE; }
+        template<typename T> T &get(int idx, T &t) {
+            memcpy(&t, _data + idx, sizeof(T));
+            return t;
+        }
+        template<typename T> const T &put(int idx, const T &t) {
+            memcpy(_data + idx, &t, sizeof(T));
+            return t;
+        }
+    private:
+        uint8_t _data[HOST_EEPROM_SIZE];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,53 @@
+/*==============================================================================================================*
+
+    @file     HostMain.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    SKETCH ENTRY POINT FOR HOST BUILDS (setup() ONCE, THEN loop() HOST_LOOPS TIMES)
+ *==============================================================================================================*/
+
+#include "Arduino.h"
+
+#ifndef HOST_LOOPS
+#define HOST_LOOPS 1
+#endif
+
+void setup();
+void loop();
+
+int main() {
+    setup();
+    for (unsigned long i=0; i<HOST_LOOPS; i++) loop();
+    return 0;
+}
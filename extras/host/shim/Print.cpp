@@ -0,0 +1,137 @@
+/*==============================================================================================================*
+
+    @file     Print.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+#include <math.h>
+#include "Print.h"
+
+/*==============================================================================================================*
+    WRITE
+ *==============================================================================================================*/
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (!write(*buffer++)) break;
+        n++;
+    }
+    return n;
+}
+
+/*==============================================================================================================*
+    PRINT / PRINTLN
+ *==============================================================================================================*/
+
+size_t Print::print(const __FlashStringHelper *str) {
+    return write(reinterpret_cast<const char *>(str));
+}
+
+size_t Print::print(const char str[]) {
+    return write(str);
+}
+
+size_t Print::print(char c) {
+    return write((uint8_t)c);
+}
+
+size_t Print::print(unsigned char n, int base) {
+    return print((unsigned long)n, base);
+}
+
+size_t Print::print(int n, int base) {
+    return print((long)n, base);
+}
+
+size_t Print::print(unsigned int n, int base) {
+    return print((unsigned long)n, base);
+}
+
+size_t Print::print(long n, int base) {
+    if (base == 0) return write((uint8_t)n);
+    if ((base == DEC) && (n < 0)) return print('-') + printNumber(-(unsigned long)n, DEC);
+    return printNumber(n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+    return (base == 0) ? write((uint8_t)n) : printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+    return printFloat(n, digits);
+}
+
+size_t Print::println() {
+    return write("\r\n");
+}
+
+/*==============================================================================================================*
+    NUMBER FORMATTING
+ *==============================================================================================================*/
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+    char buf[8 * sizeof(long) + 1];
+    char *str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if (base < 2) base = 10;
+    do {
+        char c = n % base;
+        n /= base;
+        *--str = (c < 10) ? (c + '0') : (c + 'A' - 10);
+    } while (n);
+    return write(str);
+}
+
+size_t Print::printFloat(double number, uint8_t digits) {
+    if (isnan(number)) return print("nan");
+    if (isinf(number)) return print("inf");
+    size_t n = 0;
+    if (number < 0.0) {
+        n += print('-');
+        number = -number;
+    }
+    double rounding = 0.5;
+    for (uint8_t i=0; i<digits; i++) rounding /= 10.0;
+    number += rounding;
+    unsigned long intPart = (unsigned long)number;
+    double remainder = number - (double)intPart;
+    n += printNumber(intPart, DEC);
+    if (digits) n += print('.');
+    while (digits--) {
+        remainder *= 10.0;
+        unsigned int digit = (unsigned int)remainder;
+        n += print((char)('0' + digit));
+        remainder -= digit;
+    }
+    return n;
+}
@@ -0,0 +1,86 @@
+/*==============================================================================================================*
+
+    @file     Print.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    MINIMAL PRINT CLASS FOR HOST BUILDS (SAME OVERLOADS & NUMBER FORMATTING AS THE ARDUINO CORE)
+ *==============================================================================================================*/
+
+#ifndef Print_h
+#define Print_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class __FlashStringHelper;                              // PROGMEM strings are ordinary strings on the host
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+class Print {
+    public:
+        virtual ~Print() {}
+        virtual size_t write(uint8_t) = 0;
+        virtual size_t write(const uint8_t *buffer, size_t size);
+        size_t write(const char *str) {
+            return str ? write((const uint8_t *)str, strlen(str)) : 0;
+        }
+        size_t print(const __FlashStringHelper *str);
+        size_t print(const char str[]);
+        size_t print(char c);
+        size_t print(unsigned char n, int base = DEC);
+        size_t print(int n, int base = DEC);
+        size_t print(unsigned int n, int base = DEC);
+        size_t print(long n, int base = DEC);
+        size_t print(unsigned long n, int base = DEC);
+        size_t print(double n, int digits = 2);
+        size_t println();
+        template<class T> size_t println(T value) {
+            size_t n = print(value);
+            return n + println();
+        }
+        template<class T> size_t println(T value, int format) {
+            size_t n = print(value, format);
+            return n + println();
+        }
+    private:
+        size_t printNumber(unsigned long n, uint8_t base);
+        size_t printFloat(double number, uint8_t digits);
+};
+
+#endif
@@ -0,0 +1,62 @@
+/*==============================================================================================================*
+
+    @file     Wire.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    MINIMAL 'WIRE' LIBRARY FOR HOST BUILDS (AN EMPTY BUS: EVERY ADDRESS NACKS, USE MCP3221_SimI2C INSTEAD)
+ *==============================================================================================================*/
+
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 32                                // same receive buffer length as the AVR Wire library
+
+class TwoWire {
+    public:
+        void    begin() {}
+        void    end() {}
+        void    setClock(uint32_t) {}
+        void    beginTransmission(uint8_t) {}
+        size_t  write(uint8_t) { return 1; }
+        uint8_t endTransmission(uint8_t = true) { return 2; }               // address NACK
+        uint8_t requestFrom(uint8_t, uint8_t, uint8_t = true) { return 0; }
+        int     available() { return 0; }
+        int     read() { return -1; }
+};
+
+extern TwoWire Wire;
+
+#endif
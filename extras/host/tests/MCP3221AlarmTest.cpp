@@ -0,0 +1,160 @@
+/*==============================================================================================================*
+
+    @file     MCP3221AlarmTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    THRESHOLD ALARMS (MCP3221Alarm) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Alarm.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static byte         lastEvent;
+static unsigned int lastData, callbacks;
+
+static void onAlarm(alarm_event_t event, unsigned int data) {
+    lastEvent = event;
+    lastData = data;
+    callbacks++;
+}
+
+static void feed(MCP3221Alarm &alarm, unsigned int sample, byte times = 1) {
+    for (byte i=0; i<times; i++) {
+        unsigned int data = sample;
+        alarm.process(data);
+    }
+}
+
+static void testHighAndLow() {
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Alarm alarm(device);
+    callbacks = 0;
+    alarm.setHigh(3000);
+    alarm.setLow(1000);
+    alarm.setCallback(onAlarm);
+    feed(alarm, 3000);                                  // at the threshold: not above it
+    CHECK(!alarm.isHigh());
+    feed(alarm, 3001);
+    CHECK(alarm.isHigh());
+    CHECK_EQUAL(ALARM_HIGH_SET, lastEvent);
+    CHECK_EQUAL(3001, lastData);
+    feed(alarm, 3500);                                  // edge-triggered: no repeat while set
+    CHECK_EQUAL(1, callbacks);
+    feed(alarm, 2000);
+    CHECK(!alarm.isHigh());
+    CHECK_EQUAL(ALARM_HIGH_CLEAR, lastEvent);
+    feed(alarm, 999);
+    CHECK(alarm.isLow());
+    feed(alarm, 1000);
+    CHECK(!alarm.isLow());
+    CHECK_EQUAL(ALARM_HIGH_SET | ALARM_HIGH_CLEAR | ALARM_LOW_SET | ALARM_LOW_CLEAR, alarm.getEvents());
+    CHECK_EQUAL(0, alarm.getEvents());                  // cleared by the call
+    CHECK_EQUAL(4, callbacks);
+}
+
+static void testHysteresisAndDebounce() {
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Alarm alarm(device);
+    alarm.setHigh(3000);
+    alarm.setHysteresis(50);
+    alarm.setDebounce(3);
+    feed(alarm, 3100, 2);
+    feed(alarm, 2900);                                  // the count restarts
+    feed(alarm, 3100, 2);
+    CHECK(!alarm.isHigh());
+    feed(alarm, 3100);
+    CHECK(alarm.isHigh());
+    feed(alarm, 2960, 5);                               // back below 3000, but not by the hysteresis
+    CHECK(alarm.isHigh());
+    feed(alarm, 2950, 2);
+    CHECK(alarm.isHigh());
+    feed(alarm, 2950);
+    CHECK(!alarm.isHigh());
+    alarm.reset();
+    CHECK_EQUAL(0, alarm.getEvents());
+}
+
+static void testDisabled() {
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Alarm alarm(device);
+    alarm.setHysteresis(100);
+    feed(alarm, 0);
+    feed(alarm, 4095);
+    CHECK(!alarm.isHigh());
+    CHECK(!alarm.isLow());
+    CHECK_EQUAL(0, alarm.getEvents());
+}
+
+static void testVoltageThresholds() {
+    MCP3221 device(TEST_DEV_ADDR);                      // 4096mV reference: 1 code per mV
+    MCP3221Alarm alarm(device);
+    alarm.setHighVoltage(3000);
+    alarm.setLowVoltage(1000);
+    CHECK_EQUAL(3000, alarm.getHigh());                 // readings above 3000mV
+    CHECK_EQUAL(1000, alarm.getLow());                  // readings below 1000mV
+    alarm.setLowVoltage(0);
+    CHECK_EQUAL(ALARM_LOW_OFF, alarm.getLow());
+    device.setVref(3072);                               // 0.75mV per code: converted with the new setting
+    alarm.setHighVoltage(1500);
+    CHECK_EQUAL(2000, alarm.getHigh());
+}
+
+static void testOnDevice() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Alarm alarm(device);
+    uint16_t burst[8];
+    sim.setWaveform(SIM_SQUARE, 1000, 2000, 8);         // 4 x 1000, 4 x 3000
+    device.setBus(sim);
+    alarm.setHigh(2500);
+    device.addStage(alarm);                             // sees raw readings ahead of the EMAVG smoothing
+    for (byte i=0; i<4; i++) device.getData();
+    CHECK(!alarm.isHigh());
+    device.getData();
+    CHECK(alarm.isHigh());
+    device.readBurst(burst, 8);                         // bursts are checked sample by sample
+    CHECK_EQUAL(ALARM_HIGH_SET | ALARM_HIGH_CLEAR, alarm.getEvents());
+    CHECK(alarm.isHigh());
+}
+
+int main() {
+    RUN_TEST(testHighAndLow);
+    RUN_TEST(testHysteresisAndDebounce);
+    RUN_TEST(testDisabled);
+    RUN_TEST(testVoltageThresholds);
+    RUN_TEST(testOnDevice);
+    return testResult();
+}
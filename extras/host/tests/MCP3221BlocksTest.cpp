@@ -0,0 +1,115 @@
+/*==============================================================================================================*
+
+    @file     MCP3221BlocksTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    PING-PONG BLOCK ACQUISITION (MCP3221Blocks) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Blocks.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void testBurstBlocks() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Blocks<20> blocks(device);
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);             // 0, 100, 200 ... 3900
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    CHECK_EQUAL(20, blocks.getBlockSize());
+    CHECK(blocks.getBlock() == NULL);
+    CHECK(!blocks.update(12));
+    CHECK(blocks.update());                             // the rest of the block
+    CHECK(blocks.blockReady());
+    uint16_t *block = blocks.getBlock();
+    for (byte i=0; i<20; i++) CHECK_EQUAL(i * 100, block[i]);
+    CHECK(!blocks.update(10));                          // the other buffer fills meanwhile
+    CHECK(blocks.getBlock() == block);                  // the held block isn't replaced or overwritten
+    CHECK_EQUAL(1900, block[19]);
+    blocks.release();
+    CHECK(blocks.getBlock() == NULL);
+    CHECK(blocks.update());
+    CHECK(blocks.getBlock() != block);                  // buffers alternate
+    CHECK_EQUAL(2000, blocks.getBlock()[0]);
+    CHECK_EQUAL(3900, blocks.getBlock()[19]);
+    CHECK_EQUAL(0, blocks.getOverruns());
+    CHECK_EQUAL(2, blocks.getBlocks());
+}
+
+static void testOverrun() {
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Blocks<4> blocks(device);
+    for (byte i=0; i<4; i++) blocks.push(i);
+    CHECK(blocks.blockReady());
+    for (byte i=0; i<3; i++) CHECK(!blocks.push(10 + i));
+    CHECK(!blocks.push(13));                            // completes while the ready block is still held
+    CHECK_EQUAL(2, blocks.getBlocks());
+    CHECK_EQUAL(1, blocks.getOverruns());
+    uint16_t *block = blocks.getBlock();
+    for (byte i=0; i<4; i++) CHECK_EQUAL(i, block[i]);  // the held block survived
+    blocks.release();
+    for (byte i=0; i<4; i++) blocks.push(20 + i);
+    CHECK_EQUAL(20, blocks.getBlock()[0]);              // the dropped block was refilled
+    blocks.reset();
+    CHECK(!blocks.blockReady());
+    CHECK_EQUAL(0, blocks.getBlocks());
+    CHECK_EQUAL(0, blocks.getOverruns());
+}
+
+static void testQueueBlocks() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221_Ring<32> ring;
+    MCP3221Blocks<8> blocks(device, BLOCK_QUEUE);
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    device.startAsync(ring, 4);
+    device.poll();
+    CHECK(!blocks.update());                            // drains what the ring holds
+    device.poll();
+    CHECK(blocks.update());
+    for (byte i=0; i<8; i++) CHECK_EQUAL(i * 100, blocks.getBlock()[i]);
+    CHECK(!blocks.update());                            // ring empty
+    device.stopAsync();
+}
+
+int main() {
+    RUN_TEST(testBurstBlocks);
+    RUN_TEST(testOverrun);
+    RUN_TEST(testQueueBlocks);
+    return testResult();
+}
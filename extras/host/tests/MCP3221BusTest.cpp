@@ -0,0 +1,164 @@
+/*==============================================================================================================*
+
+    @file     MCP3221BusTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    MULTI-DEVICE BUS GROUP (MCP3221Bus) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Bus.h"
+#include "utility/MCP3221_SimI2C.h"
+
+const byte OTHER_DEV_ADDR = 0x48;                       // no simulated device answers at this address
+
+static void testRoundRobin() {
+    MCP3221_SimI2C simA(TEST_DEV_ADDR), simB(TEST_DEV_ADDR);
+    MCP3221 deviceA(TEST_DEV_ADDR), deviceB(TEST_DEV_ADDR);
+    MCP3221Bus group;
+    simA.setWaveform(SIM_CONSTANT, 1000);
+    simB.setWaveform(SIM_CONSTANT, 3000);
+    deviceA.setBus(simA);
+    deviceB.setBus(simB);
+    deviceA.setSmoothing(NO_SMOOTHING);
+    deviceB.setSmoothing(NO_SMOOTHING);
+    CHECK(group.addDevice(deviceA));
+    CHECK(group.addDevice(deviceB));
+    CHECK_EQUAL(2, group.begin());
+    CHECK(group.update());                              // channel 0
+    CHECK_EQUAL(0x01, group.getUpdated());
+    CHECK(group.update());                              // channel 1
+    CHECK_EQUAL(0x02, group.getUpdated());
+    CHECK_EQUAL(0, group.getUpdated());                 // cleared on read
+    CHECK_EQUAL(1000, group.getValue(0));
+    CHECK_EQUAL(3000, group.getValues()[1]);
+    CHECK_EQUAL(2, group.updateAll());
+    CHECK_EQUAL(TEST_DEV_ADDR, group.getAddress(1));
+}
+
+class LogBus : public MCP3221_I2C {                    // one simulated device, logs every transaction's address
+    public:
+        MCP3221_SimI2C sim;
+        byte           numLog;
+        byte           log[8];
+        LogBus() : sim(TEST_DEV_ADDR), numLog(0), _addr(0) {}
+        void beginTransmission(byte devAddr) { _addr = devAddr; sim.beginTransmission(devAddr); }
+        byte endTransmission() { logAddr(_addr); return sim.endTransmission(); }
+        byte requestFrom(byte devAddr, byte numBytes) { logAddr(devAddr); return sim.requestFrom(devAddr, numBytes); }
+        int  available() { return sim.available(); }
+        int  read() { return sim.read(); }
+    private:
+        byte _addr;
+        void logAddr(byte addr) { if (numLog < sizeof(log)) log[numLog++] = addr; }
+};
+
+static void testRescanAfterLastChannel() {
+    LogBus bus;
+    MCP3221 absent(OTHER_DEV_ADDR), present(TEST_DEV_ADDR);
+    MCP3221Bus group;
+    absent.setBus(bus);
+    present.setBus(bus);
+    group.addDevice(absent);
+    group.addDevice(present);
+    group.setRescan(1);
+    CHECK_EQUAL(1, group.begin());
+    bus.numLog = 0;
+    CHECK(group.update());                              // skips channel 0, reads channel 1, ends the round
+    CHECK_EQUAL(2, bus.numLog);
+    CHECK_EQUAL(TEST_DEV_ADDR, bus.log[0]);             // the round's last read comes first...
+    CHECK_EQUAL(OTHER_DEV_ADDR, bus.log[1]);            // ...then the rescan of the absent device
+    CHECK(!group.isPresent(0));
+}
+
+static void testGroupFull() {
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Bus group;
+    for (byte i=0; i<BUS_MAX_DEVICES; i++) CHECK(group.addDevice(device));
+    CHECK(!group.addDevice(device));
+    CHECK_EQUAL(BUS_MAX_DEVICES, group.getNumDevices());
+}
+
+static void testMissingDeviceCost() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 present(TEST_DEV_ADDR), missing(OTHER_DEV_ADDR);
+    MCP3221Bus group;
+    present.setBus(sim);
+    missing.setBus(sim);
+    group.addDevice(present);
+    group.addDevice(missing);
+    group.setRescan(4);
+    CHECK_EQUAL(1, group.begin());
+    CHECK(!group.isPresent(1));
+    unsigned long transactions = sim.getTransactions();
+    for (byte i=0; i<3; i++) group.updateAll();         // absent: never read, not pinged before the rescan
+    CHECK_EQUAL(3, sim.getTransactions() - transactions);
+    transactions = sim.getTransactions();
+    group.updateAll();                                  // 4th round ends with a rescan ping
+    CHECK_EQUAL(2, sim.getTransactions() - transactions);
+    CHECK(!group.isPresent(1));
+}
+
+static void testDeadDeviceCost() {
+    MCP3221_SimI2C simA(TEST_DEV_ADDR), simB(TEST_DEV_ADDR);
+    MCP3221 deviceA(TEST_DEV_ADDR), deviceB(TEST_DEV_ADDR);
+    MCP3221Bus group;
+    deviceA.setBus(simA);
+    deviceB.setBus(simB);
+    group.addDevice(deviceA);
+    group.addDevice(deviceB);
+    CHECK_EQUAL(2, group.begin());
+    simB.setNackEvery(1);                               // device B dies after begin()
+    unsigned long transactions = simB.getTransactions();
+    CHECK(group.update());                              // A
+    CHECK(!group.update());                             // B: one read, no retries, no ping
+    CHECK_EQUAL(1, simB.getTransactions() - transactions);
+    CHECK(!group.isOnline(1));
+    CHECK(group.isPresent(1));
+    transactions = simB.getTransactions();
+    for (byte i=0; i<10; i++) group.updateAll();        // read after skipping 1, then 2, then 4 rounds
+    CHECK_EQUAL(3, simB.getTransactions() - transactions);
+    simB.setNackEvery(0);
+    for (byte i=0; i<9; i++) group.updateAll();         // read again after skipping 8 rounds
+    CHECK(group.isOnline(1));
+}
+
+int main() {
+    RUN_TEST(testRoundRobin);
+    RUN_TEST(testRescanAfterLastChannel);
+    RUN_TEST(testGroupFull);
+    RUN_TEST(testMissingDeviceCost);
+    RUN_TEST(testDeadDeviceCost);
+    return testResult();
+}
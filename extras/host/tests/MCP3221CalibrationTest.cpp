@@ -0,0 +1,204 @@
+/*==============================================================================================================*
+
+    @file     MCP3221CalibrationTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    CALIBRATION TESTS (REFERENCE POINTS, CORRECTION TABLE & EEPROM PERSISTENCE)
+ *==============================================================================================================*/
+
+// With the default 4096mV reference, 1 code reads as 1mV, so the expected voltages are easy to work out.
+
+#include "MCP3221Test.h"
+#include "EEPROM.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Calibration.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static unsigned int voltageAt(MCP3221_SimI2C &sim, MCP3221 &device, unsigned int data) {
+    sim.setWaveform(SIM_CONSTANT, data);
+    return device.getVoltage();
+}
+
+static void testUncalibrated() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    CHECK_EQUAL(1000, voltageAt(sim, device, 1000));
+    CHECK_EQUAL(1000, device.calibrate(1000));
+    CHECK_EQUAL(1000, device.voltageToData(1000));
+    CHECK(device.getCalibration() == NULL);
+    bool identity = true;                               // through the shared identity table
+    for (unsigned int code=0; code<4096; code++) identity &= (device.calibrate(code) == code);
+    CHECK(identity);
+}
+
+static void testSketchTable() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    uint16_t table[CAL_KNOTS];
+    for (byte i=0; i<CAL_KNOTS; i++) table[i] = (i << CAL_KNOT_SHIFT) + 10;   // +10 codes everywhere
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    device.setCalibration(table);                       // the device keeps a pointer, not a copy
+    CHECK(device.getCalibration() == table);
+    CHECK_EQUAL(1010, voltageAt(sim, device, 1000));
+    table[4] += 10;                                     // edits show up on the next reading
+    CHECK_EQUAL(1044, voltageAt(sim, device, 1024));
+    device.reset();
+    CHECK(device.getCalibration() == NULL);
+}
+
+static void testOffset() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Calibration calibration(device);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    CHECK(!calibration.apply());                        // no points yet
+    CHECK(calibration.addPoint(1000, 1020));
+    CHECK(calibration.apply());
+    CHECK(device.getCalibration() != NULL);             // the table is held by the calibration object
+    CHECK_EQUAL(1020, voltageAt(sim, device, 1000));
+    CHECK_EQUAL(3020, voltageAt(sim, device, 3000));
+    calibration.clear();
+    CHECK_EQUAL(0, calibration.getNumPoints());
+    CHECK(device.getCalibration() == NULL);
+    CHECK_EQUAL(3000, voltageAt(sim, device, 3000));
+}
+
+static void testOffsetAndGain() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Calibration calibration(device);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    sim.setWaveform(SIM_CONSTANT, 3000);
+    CHECK(calibration.addPoint(3100));                  // points taken from the device, in any order
+    sim.setWaveform(SIM_CONSTANT, 1000);
+    CHECK(calibration.addPoint(1050));
+    CHECK_EQUAL(2, calibration.getNumPoints());
+    CHECK(calibration.apply());
+    CHECK_NEAR(1050, voltageAt(sim, device, 1000), 1);
+    CHECK_NEAR(2075, voltageAt(sim, device, 2000), 1);
+    CHECK_NEAR(3100, voltageAt(sim, device, 3000), 1);
+    CHECK_NEAR(538, voltageAt(sim, device, 500), 1);    // outer segments are extended
+    CHECK_NEAR(2000, device.voltageToData(2075), 1);   // inverse through the same table
+}
+
+static void testPiecewise() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Calibration calibration(device);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    CHECK(calibration.addPoint(0, 0));
+    CHECK(calibration.addPoint(2048, 2000));
+    CHECK(calibration.addPoint(4095, 4095));
+    CHECK(calibration.addPoint(2048, 2100));            // a repeated reading replaces its voltage
+    CHECK_EQUAL(3, calibration.getNumPoints());
+    CHECK(calibration.apply());
+    CHECK_NEAR(1050, voltageAt(sim, device, 1024), 2);
+    CHECK_NEAR(2100, voltageAt(sim, device, 2048), 2);
+    CHECK_NEAR(3098, voltageAt(sim, device, 3072), 2);
+}
+
+static void testFullTable() {
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Calibration calibration(device);
+    for (byte i=0; i<MAX_CAL_POINTS; i++) CHECK(calibration.addPoint(i * 500, i * 510));
+    CHECK(!calibration.addPoint(4000, 4080));
+    CHECK_EQUAL(MAX_CAL_POINTS, calibration.getNumPoints());
+}
+
+static void testFailedReading() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Calibration calibration(device);
+    sim.setBusStuck(true);
+    device.setBus(sim);
+    device.setRetries(0);
+    CHECK(!calibration.addPoint(1000));
+    CHECK_EQUAL(0, calibration.getNumPoints());
+}
+
+static void testSaveAndLoad() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR), other(TEST_DEV_ADDR - 1);
+    MCP3221Calibration calibration(device);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    CHECK(!calibration.save());                         // no points yet
+    calibration.addPoint(1000, 1050);
+    calibration.addPoint(3000, 3100);
+    calibration.apply();
+    CHECK(calibration.save());
+    calibration.clear();
+    CHECK_EQUAL(2000, voltageAt(sim, device, 2000));
+    MCP3221Calibration restored(device);
+    CHECK(restored.load());
+    CHECK_EQUAL(2, restored.getNumPoints());
+    CHECK_NEAR(2075, voltageAt(sim, device, 2000), 1);
+    MCP3221Calibration otherCalibration(other);         // each address has its own slot
+    CHECK(!otherCalibration.load());
+    restored.erase();
+    MCP3221Calibration erased(device);
+    CHECK(!erased.load());
+    CHECK_EQUAL(0, erased.getNumPoints());
+}
+
+static void testCorruptSlot() {
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Calibration calibration(device);
+    calibration.addPoint(1000, 1050);
+    CHECK(calibration.save());
+    int addr = MCP3221_CAL_EEPROM_ADDR + (TEST_DEV_ADDR & 0x07) * sizeof(mcp3221_cal_record_t);
+    EEPROM.write(addr + offsetof(mcp3221_cal_record_t, mV), 0x55);   // fails the checksum
+    MCP3221Calibration loaded(device);
+    CHECK(!loaded.load());
+    CHECK_EQUAL(0, loaded.getNumPoints());
+}
+
+int main() {
+    RUN_TEST(testUncalibrated);
+    RUN_TEST(testSketchTable);
+    RUN_TEST(testOffset);
+    RUN_TEST(testOffsetAndGain);
+    RUN_TEST(testPiecewise);
+    RUN_TEST(testFullTable);
+    RUN_TEST(testFailedReading);
+    RUN_TEST(testSaveAndLoad);
+    RUN_TEST(testCorruptSlot);
+    return testResult();
+}
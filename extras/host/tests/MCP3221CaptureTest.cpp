@@ -0,0 +1,156 @@
+/*==============================================================================================================*
+
+    @file     MCP3221CaptureTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    PRE-TRIGGER CAPTURE TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Capture.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void testRisingTrigger() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Capture<16> capture;
+    uint16_t samples[64];
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);             // 0, 100, 200 ... 3900
+    device.setBus(sim);
+    device.addStage(capture);
+    capture.setTrigger(2050, TRIGGER_RISING);
+    capture.setPreTrigger(4);
+    CHECK_EQUAL(CAPTURE_IDLE, capture.getState());
+    capture.arm();
+    CHECK_EQUAL(CAPTURE_ARMED, capture.getState());
+    device.readBurst(samples, 10);
+    CHECK_EQUAL(10, capture.getLength());               // pre-trigger readings so far
+    CHECK_EQUAL(0, capture.getSample(0));
+    device.readBurst(samples, 64);
+    CHECK(capture.isDone());
+    CHECK_EQUAL(16, capture.getLength());
+    CHECK_EQUAL(4, capture.getTriggerIndex());
+    for (unsigned int i=0; i<16; i++) CHECK_EQUAL(1700 + i * 100, capture.getSample(i));
+    CHECK_EQUAL(0, capture.getSample(16));
+    device.readBurst(samples, 16);                      // the record stays frozen
+    CHECK_EQUAL(2100, capture.getSample(4));
+}
+
+static void testFallingAndLevelTriggers() {
+    MCP3221Capture<8> capture;
+    const uint16_t input[] = { 3000, 3000, 2000, 1000, 500, 400, 300, 200, 100, 50, 20 };
+    capture.setPreTrigger(2);
+    capture.setTrigger(1500, TRIGGER_FALLING);
+    capture.arm();
+    for (byte i=0; i<11; i++) {
+        unsigned int sample = input[i];
+        CHECK(capture.process(sample));                 // pass-through
+        CHECK_EQUAL(input[i], sample);
+    }
+    CHECK(capture.isDone());
+    CHECK_EQUAL(1000, capture.getSample(capture.getTriggerIndex()));
+    capture.setTrigger(350, TRIGGER_BELOW);
+    capture.arm();
+    for (byte i=0; i<11; i++) {
+        unsigned int sample = input[i];
+        capture.process(sample);
+    }
+    CHECK_EQUAL(CAPTURE_TRIGGERED, capture.getState()); // 300 fired, one reading short of a full record
+    CHECK_EQUAL(300, capture.getSample(2));
+}
+
+static void testPreTriggerFillsFirst() {
+    MCP3221Capture<8> capture;
+    capture.setPreTrigger(5);
+    capture.setTrigger(1000, TRIGGER_ABOVE);
+    capture.arm();
+    for (unsigned int i=0; i<8; i++) {
+        unsigned int sample = 2000 + i;                 // above the level from the start
+        capture.process(sample);
+    }
+    CHECK(capture.isDone());
+    CHECK_EQUAL(2000, capture.getSample(0));
+    CHECK_EQUAL(2005, capture.getSample(5));            // first reading after a full pre-trigger
+}
+
+static void testForcedTrigger() {
+    MCP3221Capture<8> capture;
+    capture.setPreTrigger(3);
+    capture.setTrigger(4000, TRIGGER_ABOVE);            // never reached
+    capture.arm();
+    capture.trigger();
+    for (unsigned int i=0; i<20; i++) {
+        unsigned int sample = i;
+        capture.process(sample);
+    }
+    CHECK(capture.isDone());
+    CHECK_EQUAL(3, capture.getSample(3));
+    capture.stop();
+    CHECK_EQUAL(CAPTURE_IDLE, capture.getState());
+    CHECK_EQUAL(0, capture.getLength());
+}
+
+static void testPreTriggerStagedUntilArm() {
+    MCP3221Capture<8> capture;
+    capture.setPreTrigger(2);
+    capture.setTrigger(100, TRIGGER_RISING);
+    capture.arm();
+    for (unsigned int i=0; i<3; i++) {
+        unsigned int sample = 10 + i;
+        capture.process(sample);
+    }
+    capture.setPreTrigger(6);                           // a running record keeps its own
+    CHECK_EQUAL(2, capture.getTriggerIndex());
+    for (unsigned int i=0; i<10; i++) {
+        unsigned int sample = 100 + i;
+        capture.process(sample);
+    }
+    CHECK(capture.isDone());
+    CHECK_EQUAL(100, capture.getSample(2));
+    capture.arm();
+    CHECK_EQUAL(6, capture.getTriggerIndex());
+    capture.setPreTrigger(100);                         // clamped to SIZE - 1
+    capture.arm();
+    CHECK_EQUAL(7, capture.getTriggerIndex());
+}
+
+int main() {
+    RUN_TEST(testRisingTrigger);
+    RUN_TEST(testFallingAndLevelTriggers);
+    RUN_TEST(testPreTriggerFillsFirst);
+    RUN_TEST(testForcedTrigger);
+    RUN_TEST(testPreTriggerStagedUntilArm);
+    return testResult();
+}
@@ -0,0 +1,137 @@
+/*==============================================================================================================*
+
+    @file     MCP3221ClockTunerTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    I2C CLOCK-RATE TUNER TESTS
+ *==============================================================================================================*/
+
+// Candidate rates: 50, 100, 150, 200, 250, 300, 400, 500, 600 & 800KHz. Above the simulator's clock limit every
+// n-th transaction NACKs, n shrinking as the clock rises, so a 64-read burst fails at the first rate above it.
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221ClockTuner.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void testMarginBelowFastestPass() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221ClockTuner tuner(device, 100000, 800000);
+    sim.setClockLimit(300000);
+    device.setBus(sim);
+    CHECK_EQUAL(0, tuner.getClock());
+    CHECK(tuner.tune());
+    CHECK_EQUAL(250000, tuner.getClock());              // default margin: one step below 300KHz
+    tuner.setMargin(0);
+    CHECK(tuner.tune());
+    CHECK_EQUAL(300000, tuner.getClock());
+    tuner.setMargin(10);
+    CHECK(tuner.tune());
+    CHECK_EQUAL(100000, tuner.getClock());              // never below the range
+}
+
+static void testAllRatesPass() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221ClockTuner tuner(device);
+    device.setBus(sim);
+    CHECK(tuner.tune());
+    CHECK_EQUAL(TUNER_MAX_CLOCK, tuner.getClock());     // no margin without a failure
+}
+
+static void testLowestRateFails() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221ClockTuner tuner(device, 200000, 400000);
+    sim.setClockLimit(100000);
+    device.setBus(sim);
+    CHECK(!tuner.tune());
+    CHECK_EQUAL(200000, tuner.getClock());
+    MCP3221ClockTuner empty(device, 410000, 450000);    // no candidate within the range
+    CHECK(!empty.tune());
+}
+
+class FixedClockBus : public MCP3221_I2C {             // a bus without clock control (& without a device)
+    public:
+        void beginTransmission(byte) {}
+        byte endTransmission() { return 2; }
+        byte requestFrom(byte, byte) { return 0; }
+        int  available() { return 0; }
+        int  read() { return -1; }
+};
+
+static void testNoClockControl() {
+    FixedClockBus bus;
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221ClockTuner tuner(device);
+    device.setBus(bus);
+    CHECK(!tuner.tune());
+    CHECK_EQUAL(0, tuner.getClock());
+    CHECK(!tuner.update());
+}
+
+static void testRetune() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221ClockTuner tuner(device, 100000, 800000);
+    sim.setClockLimit(300000);
+    device.setBus(sim);
+    tuner.setInterval(1000);
+    tuner.tune();
+    CHECK(!tuner.update());                             // not due yet
+    advanceClock(1000000UL);
+    CHECK(!tuner.update());                             // due, passes at 250KHz
+    CHECK_EQUAL(0, tuner.getRetunes());
+    sim.setClockLimit(150000);                          // wiring degrades
+    CHECK(!tuner.update());
+    advanceClock(1000000UL);
+    CHECK(tuner.update());
+    CHECK_EQUAL(1, tuner.getRetunes());
+    CHECK_EQUAL(100000, tuner.getClock());
+    tuner.setInterval(0);
+    advanceClock(1000000UL);
+    sim.setClockLimit(50000);
+    CHECK(!tuner.update());                             // re-checks disabled
+    CHECK_EQUAL(1, tuner.getRetunes());
+}
+
+int main() {
+    RUN_TEST(testMarginBelowFastestPass);
+    RUN_TEST(testAllRatesPass);
+    RUN_TEST(testLowestRateFails);
+    RUN_TEST(testNoClockControl);
+    RUN_TEST(testRetune);
+    return testResult();
+}
@@ -0,0 +1,143 @@
+/*==============================================================================================================*
+
+    @file     MCP3221ComStatsTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    I2C COMMUNICATION STATISTICS (getComStats() / MCP3221StatsStr) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221StatsStr.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static char text[STATS_BUFFER_SIZE];
+
+static void testDisabledByDefault() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    for (byte i=0; i<5; i++) device.getData();
+    CHECK_EQUAL(0, device.getComStats().reads);
+    CHECK(strstr(MCP3221StatsStr(device, text, sizeof(text)), "setComStats()") != NULL);
+}
+
+static void testCounters() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    mcp3221_com_stats_t comStats;
+    uint16_t burst[40];
+    device.setBus(sim);
+    device.setComStats(&comStats);
+    for (byte i=0; i<5; i++) device.getData();
+    CHECK_EQUAL(5, comStats.reads);
+    CHECK_EQUAL(5, comStats.samples);
+    device.readBurst(burst, 40);                        // 16 + 16 + 8 samples
+    CHECK_EQUAL(8, comStats.reads);
+    CHECK_EQUAL(45, comStats.samples);
+    CHECK_EQUAL(0, comStats.shortReads);
+    sim.setNackEvery(3);                                // 9th transaction fails, the retry succeeds
+    device.getData();
+    CHECK_EQUAL(1, comStats.shortReads);
+    CHECK_EQUAL(1, comStats.retries);
+    CHECK_EQUAL(1, comStats.comCodes[0]);               // the ping after the failed read finds the device
+    CHECK_EQUAL(comStats.reads, comStats.timedReads);
+    device.resetComStats();
+    CHECK_EQUAL(0, comStats.reads);
+    CHECK_EQUAL(0xFFFFFFFF, comStats.minTime);
+}
+
+static void testLatency() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    mcp3221_com_stats_t comStats;
+    device.setBus(sim);
+    device.setComStats(&comStats);
+    sim.setLatency(100);
+    for (byte i=0; i<4; i++) device.getData();
+    sim.setLatency(1000);
+    device.getData();
+    CHECK_NEAR(100, comStats.minTime, 2);               // the simulated clock ticks once per micros() call
+    CHECK_NEAR(1000, comStats.maxTime, 2);
+    CHECK_NEAR(1400, comStats.totalTime, 10);
+    CHECK_EQUAL(4, comStats.latency[6]);                // 64 - 127uS
+    CHECK_EQUAL(1, comStats.latency[9]);                // 512 - 1023uS
+}
+
+static void testAsyncKeepsTimingStats() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221_Ring<32> ring;
+    mcp3221_com_stats_t comStats;
+    device.setBus(sim);
+    device.setComStats(&comStats);
+    sim.setLatency(100);
+    device.getData();
+    device.startAsync(ring, 4);
+    for (byte i=0; i<3; i++) device.poll();
+    CHECK_EQUAL(4, comStats.reads);
+    CHECK_EQUAL(13, comStats.samples);
+    CHECK_EQUAL(1, comStats.timedReads);                // async transfers don't count as 0uS reads
+    CHECK_NEAR(100, comStats.minTime, 2);
+    CHECK_EQUAL(1, comStats.latency[6]);
+    CHECK_EQUAL(0, comStats.latency[0]);
+}
+
+static void testStatsText() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    mcp3221_com_stats_t comStats;
+    device.setBus(sim);
+    device.setComStats(&comStats);
+    sim.setLatency(100);
+    for (byte i=0; i<7; i++) device.getData();
+    MCP3221_PString str = MCP3221StatsStr(device, text, sizeof(text));
+    CHECK(strstr(str, "READS:\t\t   7\n") != NULL);
+    CHECK(strstr(str, "SAMPLES:\t   7\n") != NULL);
+    CHECK(strstr(str, "MIN 10") != NULL);
+    CHECK(strlen(text) < sizeof(text) - 1);             // STATS_BUFFER_SIZE holds the whole text
+    char small[40];
+    MCP3221_PString truncated = MCP3221StatsStr(device, small, sizeof(small));
+    CHECK_EQUAL(sizeof(small) - 1, truncated.length());
+    CHECK_EQUAL(0, strncmp(small, text, sizeof(small) - 1));
+}
+
+int main() {
+    RUN_TEST(testDisabledByDefault);
+    RUN_TEST(testCounters);
+    RUN_TEST(testLatency);
+    RUN_TEST(testAsyncKeepsTimingStats);
+    RUN_TEST(testStatsText);
+    return testResult();
+}
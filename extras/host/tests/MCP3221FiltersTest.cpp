@@ -0,0 +1,191 @@
+/*==============================================================================================================*
+
+    @file     MCP3221FiltersTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    FILTER PIPELINE STAGE TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Filters.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void checkBlockMatchesSamples(MCP3221Stage &sampleStage, MCP3221Stage &blockStage, const uint16_t *input,
+                                     size_t count) {
+    uint16_t block[64];
+    size_t numOut = 0;
+    for (size_t i=0; i<count; i++) block[i] = input[i];
+    size_t numBlock = blockStage.processBlock(block, count);
+    for (size_t i=0; i<count; i++) {
+        unsigned int sample = input[i];
+        if (!sampleStage.process(sample)) continue;
+        CHECK(numOut < numBlock);
+        CHECK_EQUAL(sample, block[numOut]);
+        numOut++;
+    }
+    CHECK_EQUAL(numOut, numBlock);
+}
+
+static void testRollingAvg() {
+    MCP3221RollingAvg<4> stage, blockStage;
+    const uint16_t input[] = { 0, 100, 200, 300, 400, 500 };
+    const unsigned int expected[] = { 0, 50, 100, 150, 250, 350 };
+    for (byte i=0; i<6; i++) {
+        unsigned int sample = input[i];
+        CHECK(stage.process(sample));
+        CHECK_EQUAL(expected[i], sample);
+    }
+    stage.reset();
+    checkBlockMatchesSamples(stage, blockStage, input, 6);
+}
+
+static void testMedian() {
+    MCP3221Median<3> stage, blockStage;
+    const uint16_t input[] = { 1000, 1000, 4000, 1000, 1010, 0, 1020 };
+    for (byte i=0; i<7; i++) {
+        unsigned int sample = input[i];
+        CHECK(stage.process(sample));
+        if (i >= 2) CHECK_NEAR(1010, sample, 10);       // single spikes never pass
+    }
+    stage.reset();
+    checkBlockMatchesSamples(stage, blockStage, input, 7);
+}
+
+static void testEma() {
+    MCP3221Ema stage(64), blockStage(64);
+    MCP3221_EmaCore ema;
+    CHECK_EQUAL(64, stage.getAlpha());
+    ema.setAlpha(64);
+    ema.reset();
+    const uint16_t input[] = { 1000, 3000, 3000, 3000, 500, 4095, 0, 2048 };
+    for (byte i=0; i<8; i++) {
+        unsigned int sample = input[i];
+        CHECK(stage.process(sample));
+        CHECK_EQUAL(ema.update(input[i]), sample);
+    }
+    stage.reset();
+    checkBlockMatchesSamples(stage, blockStage, input, 8);
+    stage.setAlpha(0);
+    CHECK_EQUAL(MIN_ALPHA, stage.getAlpha());
+    stage.setAlpha(1000);
+    CHECK_EQUAL(MAX_ALPHA, stage.getAlpha());
+}
+
+static void testDecimator() {
+    MCP3221Decimator stage(4), blockStage(4);
+    CHECK_EQUAL(4, stage.getFactor());
+    const uint16_t input[] = { 100, 200, 300, 400, 1000, 1000, 1000, 1001, 7, 9 };
+    unsigned int sample;
+    for (byte i=0; i<3; i++) {
+        sample = input[i];
+        CHECK(!stage.process(sample));                  // consumed until the group is complete
+    }
+    sample = input[3];
+    CHECK(stage.process(sample));
+    CHECK_EQUAL(250, sample);
+    stage.reset();
+    uint16_t block[10];
+    for (byte i=0; i<10; i++) block[i] = input[i];
+    CHECK_EQUAL(1, blockStage.processBlock(block, 6));  // partial groups carry over between blocks
+    CHECK_EQUAL(1, blockStage.processBlock(block + 6, 4));
+    CHECK_EQUAL(250, block[0]);
+    CHECK_EQUAL(1000, block[6]);                        // 1000.25 rounded
+    blockStage.reset();
+    checkBlockMatchesSamples(stage, blockStage, input, 10);
+}
+
+static void testHampel() {
+    MCP3221Hampel stage;
+    const uint16_t input[] = { 2000, 2002, 1998, 2001, 3500, 1999, 2000, 600, 2003 };
+    for (byte i=0; i<9; i++) {
+        unsigned int sample = input[i];
+        CHECK(stage.process(sample));
+        CHECK_NEAR(2000, sample, 5);
+    }
+    CHECK_EQUAL(2, stage.getRejected());
+    unsigned int sample = 0;
+    for (byte i=0; i<5; i++) {                          // a step is held back only until it fills half the window
+        sample = 3000;
+        stage.process(sample);
+    }
+    CHECK_EQUAL(3000, sample);
+    stage.reset();
+    CHECK_EQUAL(0, stage.getRejected());
+    MCP3221Hampel blockStage;
+    checkBlockMatchesSamples(stage, blockStage, input, 9);
+}
+
+static void testPipelineOnDevice() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Decimator decimator(2);
+    MCP3221RollingAvg<2> average;
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);             // 0, 100, 200 ... 3900
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    device.addStage(decimator);                         // stages run in the order they were added
+    device.addStage(average);
+    unsigned int data;
+    CHECK_EQUAL(SAMPLE_VALID, device.readData(data));   // consumed by the decimator
+    CHECK_EQUAL(50, device.getData());
+    CHECK_EQUAL(50, device.getData());                  // held while the decimator collects
+    CHECK_EQUAL(150, device.getData());                 // (50 + 250) / 2
+    device.clearStages();
+    CHECK_EQUAL(400, device.getData());
+}
+
+static void testBurstThroughPipeline() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Decimator decimator(4);
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    device.addStage(decimator);
+    uint16_t samples[32];
+    CHECK_EQUAL(8, device.readBurst(samples, 32));
+    for (byte i=0; i<8; i++) CHECK_EQUAL(150 + i * 400, samples[i]);
+}
+
+int main() {
+    RUN_TEST(testRollingAvg);
+    RUN_TEST(testMedian);
+    RUN_TEST(testEma);
+    RUN_TEST(testDecimator);
+    RUN_TEST(testHampel);
+    RUN_TEST(testPipelineOnDevice);
+    RUN_TEST(testBurstThroughPipeline);
+    return testResult();
+}
@@ -0,0 +1,162 @@
+/*==============================================================================================================*
+
+    @file     MCP3221LogTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    BINARY SAMPLE LOG TESTS (ENCODER -> DECODER ROUND TRIPS, RESYNCHRONIZATION)
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Log.h"
+#include "utility/MCP3221_SimI2C.h"
+
+const unsigned int LOG_CAPACITY = 4096;
+
+class LogBuffer {                                       // encoder sink
+    public:
+        LogBuffer() : length(0) {}
+        void write(uint8_t data) {
+            if (length < LOG_CAPACITY) bytes[length] = data;
+            length++;
+        }
+        uint8_t      bytes[LOG_CAPACITY];
+        unsigned int length;
+};
+
+static unsigned int decode(const uint8_t *bytes, unsigned int length, MCP3221LogDecoder &decoder,
+                           uint16_t *samples, uint32_t *timestamps = NULL) {
+    unsigned int numSamples = 0;
+    for (unsigned int i=0; i<length; i++) {
+        if (!decoder.feed(bytes[i])) continue;
+        if (timestamps) timestamps[numSamples] = decoder.getTimestamp();
+        samples[numSamples++] = decoder.getSample();
+    }
+    return numSamples;
+}
+
+static void checkRoundTrip(log_mode_t mode, uint8_t blockSize, const uint16_t *input, unsigned int count) {
+    LogBuffer log;
+    MCP3221LogEncoder<LogBuffer> encoder(log, TEST_DEV_ADDR, mode, blockSize);
+    for (unsigned int i=0; i<count; i++) encoder.write(input[i], 1000 + i);
+    encoder.end();
+    MCP3221LogDecoder decoder;
+    uint16_t output[512];
+    uint32_t timestamps[512];
+    CHECK_EQUAL(count, decode(log.bytes, log.length, decoder, output, timestamps));
+    for (unsigned int i=0; i<count; i++) {
+        CHECK_EQUAL(input[i] & 0x0FFF, output[i]);
+        CHECK_EQUAL(1000 + i - (i % blockSize), timestamps[i]);   // the block's first sample
+    }
+    CHECK_EQUAL(TEST_DEV_ADDR, decoder.getAddress());
+    CHECK_EQUAL(mode, decoder.getMode());
+    CHECK_EQUAL(0, decoder.getSyncErrors());
+}
+
+static void readSamples(uint16_t *samples, unsigned int count, sim_waveform_t wave) {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    sim.setWaveform(wave, 100, 3900, 37);
+    sim.setNoise(3);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    CHECK_EQUAL(count, device.readBurst(samples, count));
+}
+
+static void testPackedRoundTrip() {
+    uint16_t samples[300];
+    readSamples(samples, 300, SIM_SINE);
+    checkRoundTrip(LOG_PACKED, LOG_DEFAULT_BLOCK, samples, 300);
+    checkRoundTrip(LOG_PACKED, 7, samples, 51);         // odd blocks & an odd final block
+    checkRoundTrip(LOG_PACKED, 1, samples, 5);
+}
+
+static void testDeltaRoundTrip() {
+    uint16_t samples[300];
+    readSamples(samples, 300, SIM_SQUARE);              // full-scale jumps take 2 bytes
+    checkRoundTrip(LOG_DELTA, LOG_DEFAULT_BLOCK, samples, 300);
+    const uint16_t extremes[] = { 0, 4095, 0, 4095, 4095, 1, 0xFFFF };
+    checkRoundTrip(LOG_DELTA, 3, extremes, 7);
+}
+
+static void testSize() {
+    LogBuffer packed, delta;
+    MCP3221LogEncoder<LogBuffer> packedEncoder(packed, TEST_DEV_ADDR, LOG_PACKED, 64);
+    MCP3221LogEncoder<LogBuffer> deltaEncoder(delta, TEST_DEV_ADDR, LOG_DELTA, 64);
+    for (unsigned int i=0; i<128; i++) {
+        packedEncoder.write(2000 + (i & 7), 0);
+        deltaEncoder.write(2000 + (i & 7), 0);
+    }
+    CHECK_EQUAL(2 * (LOG_HEADER_BYTES + 96), packed.length);    // 1.5 bytes per sample
+    CHECK_EQUAL(2 * (LOG_HEADER_BYTES + 65), delta.length);     // 1 byte per small step (+1 for the first sample)
+}
+
+static void testResync() {
+    LogBuffer log;
+    MCP3221LogEncoder<LogBuffer> encoder(log, TEST_DEV_ADDR, LOG_PACKED, 10);
+    for (uint16_t i=0; i<30; i++) encoder.write(i * 100, i);
+    encoder.end();
+    uint8_t damaged[LOG_CAPACITY];
+    unsigned int length = 0;
+    for (unsigned int i=0; i<log.length; i++) {
+        if ((i >= 3) && (i < 12)) continue;             // first header & samples lost
+        damaged[length++] = log.bytes[i];
+    }
+    damaged[(LOG_HEADER_BYTES + 15) - 9 + 2] ^= 0xFF;   // second block's flags: bad check byte
+    MCP3221LogDecoder decoder;
+    uint16_t output[30];
+    CHECK_EQUAL(10, decode(damaged, length, decoder, output));   // only the third block survives
+    for (uint16_t i=0; i<10; i++) CHECK_EQUAL((i + 20) * 100, output[i]);
+    CHECK(decoder.getSyncErrors() > 0);
+}
+
+static void testJoinMidStream() {
+    LogBuffer log;
+    MCP3221LogEncoder<LogBuffer> encoder(log, TEST_DEV_ADDR, LOG_DELTA, 16);
+    for (uint16_t i=0; i<48; i++) encoder.write(4000 - i * 50, 7);
+    MCP3221LogDecoder decoder;
+    uint16_t output[48];
+    unsigned int numSamples = decode(log.bytes + 20, log.length - 20, decoder, output);
+    CHECK_EQUAL(32, numSamples);                        // from the next header on
+    for (uint16_t i=0; i<32; i++) CHECK_EQUAL(4000 - (i + 16) * 50, output[i]);
+}
+
+int main() {
+    RUN_TEST(testPackedRoundTrip);
+    RUN_TEST(testDeltaRoundTrip);
+    RUN_TEST(testSize);
+    RUN_TEST(testResync);
+    RUN_TEST(testJoinMidStream);
+    return testResult();
+}
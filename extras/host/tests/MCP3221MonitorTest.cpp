@@ -0,0 +1,134 @@
+/*==============================================================================================================*
+
+    @file     MCP3221MonitorTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    CHANGE MONITOR (MCP3221Monitor) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Monitor.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static bool updateAfter(MCP3221Monitor &monitor, unsigned long ms) {
+    advanceClock(ms * 1000);
+    return monitor.update();
+}
+
+static void testFirstReadingReported() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    sim.setWaveform(SIM_CONSTANT, 2000);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    MCP3221Monitor monitor(device);
+    CHECK(monitor.update());                            // polls at once and reports the first reading
+    CHECK_EQUAL(2000, monitor.getValue());
+    CHECK(monitor.isActive());
+    CHECK(!monitor.update());                           // interval not elapsed: no read
+}
+
+static void testDeadband() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    sim.setWaveform(SIM_CONSTANT, 2000);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    MCP3221Monitor monitor(device, 8, 4);
+    monitor.setInterval(10, 80);
+    CHECK(monitor.update());
+    sim.setWaveform(SIM_CONSTANT, 2006);
+    CHECK(updateAfter(monitor, 10));                    // moving: the deadband narrows to 8 - 4
+    CHECK_EQUAL(2006, monitor.getValue());
+    CHECK(!updateAfter(monitor, 10));                   // a quiet poll ends the activity...
+    CHECK(!monitor.isActive());
+    sim.setWaveform(SIM_CONSTANT, 2012);
+    CHECK(!updateAfter(monitor, 20));                   // ... so a change of 6 is noise again
+    CHECK_EQUAL(2006, monitor.getValue());
+    sim.setWaveform(SIM_CONSTANT, 1997);
+    CHECK(updateAfter(monitor, 40));                    // 9 counts down: beyond the full deadband
+    CHECK_EQUAL(1997, monitor.getValue());
+}
+
+static void testBackoff() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    sim.setWaveform(SIM_CONSTANT, 2000);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    MCP3221Monitor monitor(device);
+    monitor.setInterval(10, 80);
+    CHECK(monitor.update());
+    CHECK_EQUAL(10, monitor.getInterval());
+    const unsigned long intervals[] = { 20, 40, 80, 80 };
+    for (byte i=0; i<4; i++) {
+        CHECK(!updateAfter(monitor, monitor.getInterval()));
+        CHECK_EQUAL(intervals[i], monitor.getInterval());
+    }
+    CHECK(!updateAfter(monitor, 79));                   // no poll before the interval has elapsed
+    CHECK_EQUAL(80, monitor.getInterval());
+    sim.setWaveform(SIM_CONSTANT, 2100);
+    CHECK(updateAfter(monitor, 1));
+    CHECK_EQUAL(10, monitor.getInterval());             // a change restores the minimum interval
+}
+
+static void testFailedReadsBackOff() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    sim.setWaveform(SIM_CONSTANT, 2000);
+    sim.setBusStuck(true);
+    device.setBus(sim);
+    device.setRetries(0);
+    MCP3221Monitor monitor(device);
+    monitor.setInterval(10, 80);
+    unsigned long transactions = sim.getTransactions();
+    CHECK(!monitor.update());                           // failed reads are never reported
+    CHECK_EQUAL(20, monitor.getInterval());
+    CHECK(!monitor.update());                           // ... nor retried on every pass
+    CHECK(sim.getTransactions() - transactions <= 2);   // the read and the ping after it
+    sim.setBusStuck(false);
+    CHECK(updateAfter(monitor, 20));
+    CHECK_EQUAL(2000, monitor.getValue());
+    monitor.reset();
+    CHECK(monitor.update());                            // reset() reports the next reading at once
+}
+
+int main() {
+    RUN_TEST(testFirstReadingReported);
+    RUN_TEST(testDeadband);
+    RUN_TEST(testBackoff);
+    RUN_TEST(testFailedReadsBackOff);
+    return testResult();
+}
@@ -0,0 +1,95 @@
+/*==============================================================================================================*
+
+    @file     MCP3221OversamplingTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    OVERSAMPLING & DECIMATION (readOversampled() / getOversampled()) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void testOversampled() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    unsigned int data;
+    sim.setWaveform(SIM_SQUARE, 1000, 1, 2);            // alternates 1000 / 1001: half a code of dither
+    device.setBus(sim);
+    CHECK_EQUAL(SAMPLE_VALID, device.readOversampled(2, data));
+    CHECK_EQUAL(4002, data);                            // 1000.5 in quarter codes
+    CHECK_EQUAL(16008, device.getOversampled(4));
+    sim.setNackEvery(5);                                // failed bursts are retried
+    CHECK_EQUAL(SAMPLE_VALID, device.readOversampled(3, data));
+    CHECK_EQUAL(8004, data);
+    sim.setNackEvery(0);
+    sim.setBusStuck(true);
+    device.setRetries(0);                               // a retry would recover the bus
+    CHECK_EQUAL(SAMPLE_STALE, device.readOversampled(1, data));
+    CHECK_EQUAL(2001, data);                            // last result at the requested resolution
+}
+
+static void testOversampledFailed() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    unsigned int data;
+    sim.setBusStuck(true);
+    device.setBus(sim);
+    device.setRetries(0);
+    CHECK_EQUAL(SAMPLE_FAILED, device.readOversampled(2, data));
+    CHECK_EQUAL(0, data);
+    CHECK_EQUAL(0, device.getOversampledVoltage(2));
+}
+
+static void testBurstsAndLimits() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    unsigned int data;
+    sim.setWaveform(SIM_CONSTANT, 4095);
+    device.setBus(sim);
+    device.setSmoothing(ROLLING_AVG);                   // oversampling bypasses the smoothing filters
+    CHECK_EQUAL(SAMPLE_VALID, device.readOversampled(4, data));
+    CHECK_EQUAL(65520, data);                           // full scale at 16 bits: no overflow
+    CHECK_EQUAL(16, sim.getTransactions());             // 256 samples, 16 per transaction (32-byte buffer)
+    CHECK_EQUAL(65520, device.getOversampled(9));       // extra bits capped at MAX_EXTRA_BITS
+    CHECK_EQUAL(8190, device.getOversampled(0));        // ... and raised to MIN_EXTRA_BITS
+    CHECK_EQUAL(33, sim.getTransactions());
+}
+
+int main() {
+    RUN_TEST(testOversampled);
+    RUN_TEST(testOversampledFailed);
+    RUN_TEST(testBurstsAndLimits);
+    return testResult();
+}
@@ -0,0 +1,107 @@
+/*==============================================================================================================*
+
+    @file     MCP3221RetryTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    READ RETRIES, BUS RECOVERY & STALE DATA SIGNALING TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void testRetriesHideNacks() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    mcp3221_com_stats_t comStats;
+    device.setComStats(&comStats);
+    sim.setWaveform(SIM_CONSTANT, 1500);
+    sim.setNackEvery(3);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    for (byte i=0; i<30; i++) {
+        unsigned int data;
+        CHECK_EQUAL(SAMPLE_VALID, device.readData(data));
+        CHECK_EQUAL(1500, data);
+    }
+    CHECK(device.getComStats().retries > 0);
+}
+
+static void testStaleAndFailed() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    unsigned int data;
+    sim.setWaveform(SIM_CONSTANT, 1500);
+    sim.setBusStuck(true);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    device.setRetries(0);
+    CHECK_EQUAL(SAMPLE_FAILED, device.readData(data));  // no valid reading yet
+    CHECK_EQUAL(0, data);
+    sim.setBusStuck(false);
+    CHECK_EQUAL(SAMPLE_VALID, device.readData(data));
+    sim.setWaveform(SIM_CONSTANT, 2500);
+    sim.setBusStuck(true);
+    CHECK_EQUAL(SAMPLE_STALE, device.readData(data));   // last valid reading held
+    CHECK_EQUAL(1500, data);
+    CHECK(device.getComResult() >= COM_BUS_ERROR);
+    device.setRetries(DEFAULT_MAX_RETRIES);             // the retry recovers the bus
+    CHECK_EQUAL(SAMPLE_VALID, device.readData(data));
+    CHECK_EQUAL(2500, data);
+    CHECK(sim.getRecoveries() > 0);
+}
+
+static void testRetryLimits() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    unsigned int data;
+    sim.setNackEvery(1);                                // device gone
+    device.setBus(sim);
+    device.setRetries(3);
+    CHECK_EQUAL(SAMPLE_FAILED, device.readData(data));
+    CHECK_EQUAL(8, sim.getTransactions());              // 4 attempts, each followed by a ping
+    CHECK_EQUAL(2, device.getComResult());               // address NACK'ed
+    CHECK_EQUAL(0, sim.getRecoveries());                // an absent device isn't a bus error
+    device.setRetries(100, 2000);
+    sim.setLatency(500);
+    device.readData(data);
+    CHECK(sim.getTransactions() - 8 <= 6);              // the time budget ends the retries first
+}
+
+int main() {
+    RUN_TEST(testRetriesHideNacks);
+    RUN_TEST(testStaleAndFailed);
+    RUN_TEST(testRetryLimits);
+    return testResult();
+}
@@ -0,0 +1,203 @@
+/*==============================================================================================================*
+
+    @file     MCP3221RingTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    SAMPLE RING & ASYNCHRONOUS ACQUISITION TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221_Ring.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void testFillAndDrain() {
+    MCP3221_Ring<8> ring;
+    CHECK_EQUAL(7, ring.capacity());                    // one slot is kept free
+    for (uint16_t i=0; i<7; i++) CHECK(ring.push(i * 100));
+    CHECK(!ring.push(700));
+    CHECK_EQUAL(1, ring.getOverruns());
+    CHECK_EQUAL(7, ring.available());
+    uint16_t sample;
+    for (uint16_t i=0; i<7; i++) {
+        CHECK(ring.pop(sample));
+        CHECK_EQUAL(i * 100, sample);
+    }
+    CHECK_EQUAL(0, ring.available());
+    CHECK(!ring.pop(sample));
+}
+
+static void testWrapAround() {
+    MCP3221_Ring<5> ring;
+    uint16_t next = 0, expected = 0, sample;
+    for (byte round=0; round<20; round++) {
+        for (byte i=0; i<3; i++) CHECK(ring.push(next++));
+        CHECK_EQUAL(3, ring.available());
+        for (byte i=0; i<3; i++) {
+            CHECK(ring.pop(sample));
+            CHECK_EQUAL(expected++, sample);
+        }
+    }
+    CHECK_EQUAL(0, ring.getOverruns());
+}
+
+static void testClear() {
+    MCP3221_Ring<4> ring;
+    for (byte i=0; i<5; i++) ring.push(i);
+    CHECK_EQUAL(2, ring.getOverruns());
+    ring.clear();
+    CHECK_EQUAL(0, ring.available());
+    CHECK_EQUAL(0, ring.getOverruns());
+    CHECK(ring.push(42));
+    uint16_t sample;
+    CHECK(ring.pop(sample));
+    CHECK_EQUAL(42, sample);
+}
+
+static void testOverrunSaturates() {
+    MCP3221_Ring<2> ring;
+    ring.push(1);
+    for (int i=0; i<300; i++) ring.push(2);
+    CHECK_EQUAL(255, ring.getOverruns());
+}
+
+static void testAsyncAcquisition() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221_Ring<32> ring;
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);             // 0, 100, 200 ... 3900
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    device.startAsync(ring, 4);
+    for (byte i=0; i<3; i++) device.poll();
+    CHECK_EQUAL(12, device.available());
+    uint16_t samples[12];
+    CHECK_EQUAL(12, device.read(samples, 12));
+    for (byte i=0; i<12; i++) CHECK_EQUAL(i * 100, samples[i]);
+    CHECK_EQUAL(0, device.read());                      // nothing queued
+    device.poll();
+    CHECK_EQUAL(1200, device.read());
+    device.stopAsync();
+    CHECK_EQUAL(0, device.available());
+}
+
+static void testAsyncNonBlocking() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221_Ring<16> ring;
+    sim.setWaveform(SIM_CONSTANT, 1234);
+    sim.setLatency(500);
+    sim.setNonBlocking(true);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    device.startAsync(ring, 2);
+    device.poll();                                      // starts the transfer
+    device.poll();                                      // still in flight
+    CHECK_EQUAL(0, device.available());
+    advanceClock(500);
+    device.poll();                                      // collects it & starts the next one
+    CHECK_EQUAL(2, device.available());
+    CHECK_EQUAL(1234, device.read());
+}
+
+static void testAsyncStatsFoldedByPoll() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221_Ring<16> ring;
+    mcp3221_com_stats_t comStats;
+    device.setComStats(&comStats);
+    sim.setLatency(500);
+    sim.setNonBlocking(true);
+    device.setBus(sim);
+    device.startAsync(ring, 2);
+    device.poll();                                      // starts the first transfer
+    advanceClock(500);
+    device.onTransferComplete();                        // as if from the bus's ISR: collects & restarts
+    advanceClock(500);
+    device.onTransferComplete();
+    CHECK_EQUAL(4, device.available());
+    CHECK_EQUAL(0, device.getComStats().reads);         // nothing recorded from the ISR
+    device.poll();                                      // third transfer still in flight: only folds the tallies
+    const mcp3221_com_stats_t &stats = device.getComStats();
+    CHECK_EQUAL(2, stats.reads);
+    CHECK_EQUAL(4, stats.samples);
+    CHECK_EQUAL(0, stats.shortReads);
+    CHECK_EQUAL(0, stats.timedReads);                   // transfer time unknown: timing figures untouched
+    CHECK_EQUAL(0, stats.totalTime);
+    CHECK_EQUAL(0, stats.latency[0]);
+}
+
+static void testAsyncRestartWaits() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221_Ring<16> ring, other;
+    sim.setLatency(500);
+    sim.setNonBlocking(true);
+    device.setBus(sim);
+    device.startAsync(ring, 2);
+    device.poll();                                      // transfer in flight until 500uS
+    device.startAsync(other, 2);                        // waits for it rather than abandoning it mid-flight
+    CHECK(micros() >= 500);
+    CHECK(!sim.requestPending());
+    CHECK_EQUAL(0, device.available());                 // the old transfer's samples are dropped
+    device.poll();
+    advanceClock(500);
+    device.poll();
+    CHECK_EQUAL(2, other.available());
+    CHECK_EQUAL(0, ring.available());
+}
+
+static void testAsyncOverrun() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221_Ring<8> ring;
+    device.setBus(sim);
+    device.startAsync(ring, 4);
+    for (byte i=0; i<3; i++) device.poll();             // 12 samples into 7 free slots
+    CHECK_EQUAL(7, device.available());
+    CHECK_EQUAL(5, ring.getOverruns());
+}
+
+int main() {
+    RUN_TEST(testFillAndDrain);
+    RUN_TEST(testWrapAround);
+    RUN_TEST(testClear);
+    RUN_TEST(testOverrunSaturates);
+    RUN_TEST(testAsyncAcquisition);
+    RUN_TEST(testAsyncNonBlocking);
+    RUN_TEST(testAsyncStatsFoldedByPoll);
+    RUN_TEST(testAsyncRestartWaits);
+    RUN_TEST(testAsyncOverrun);
+    return testResult();
+}
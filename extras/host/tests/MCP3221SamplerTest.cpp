@@ -0,0 +1,140 @@
+/*==============================================================================================================*
+
+    @file     MCP3221SamplerTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    FIXED-RATE SAMPLER (MCP3221Sampler) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Sampler.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void testFixedRate() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Sampler sampler(device, 1000);
+    mcp3221_sample_t sample;
+    device.setBus(sim);
+    CHECK_EQUAL(1000, sampler.getPeriod());
+    sampler.begin();
+    CHECK(!sampler.poll(sample));
+    byte captured = 0;
+    for (byte i=0; i<10; i++) {
+        advanceClock(1000);
+        if (sampler.poll(sample)) captured++;
+    }
+    CHECK_EQUAL(10, captured);
+    CHECK_EQUAL(SAMPLE_VALID, sample.status);
+    CHECK_EQUAL(0, sampler.getJitterStats().missed);
+}
+
+static void testMissedDeadlines() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Sampler sampler(device, 1000);
+    mcp3221_sample_t sample;
+    device.setBus(sim);
+    sampler.begin();
+    advanceClock(3500);                                 // deadlines at 1000, 2000 & 3000uS have passed
+    CHECK(sampler.poll(sample));
+    CHECK(!sampler.poll(sample));                       // skipped deadlines aren't read in a burst
+    CHECK_EQUAL(2, sampler.getJitterStats().missed);
+    CHECK_EQUAL(1, sampler.getJitterStats().samples);
+    CHECK_NEAR(500, sampler.getJitterStats().maxJitter, 5);
+}
+
+static void testFractionalPeriod() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Sampler sampler(device, 7000);               // 142.857uS
+    mcp3221_sample_t sample;
+    device.setBus(sim);
+    CHECK_EQUAL(7000, sampler.getRate());
+    CHECK_EQUAL(142, sampler.getPeriod());
+    sampler.begin();
+    unsigned long start = sampler.getDeadline() - 142;  // first deadline rounds down
+    advanceClock(1000000UL);                            // exactly 7000 periods
+    CHECK(sampler.poll(sample));
+    CHECK_EQUAL(6999, sampler.getJitterStats().missed);
+    CHECK_EQUAL(1000142UL, sampler.getDeadline() - start);
+    advanceClock(1000000UL);
+    CHECK(sampler.poll(sample));
+    CHECK_EQUAL(13998, sampler.getJitterStats().missed);
+    CHECK_EQUAL(2000142UL, sampler.getDeadline() - start);  // no drift over the following second either
+}
+
+static void testWithoutBegin() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Sampler sampler(device, 1000);
+    mcp3221_sample_t sample;
+    device.setBus(sim);
+    advanceClock(10000000UL);                           // 10s after reset: 10000 periods since a deadline of 0
+    CHECK(sampler.poll(sample));                        // the first poll() starts the schedule
+    CHECK(!sampler.poll(sample));
+    CHECK_EQUAL(0, sampler.getJitterStats().missed);
+    CHECK(sampler.getJitterStats().maxJitter < 5);
+    advanceClock(1000);
+    CHECK(sampler.poll(sample));
+    CHECK_EQUAL(2, sampler.getJitterStats().samples);
+    CHECK_EQUAL(0, sampler.getJitterStats().missed);
+}
+
+static void testTimerDriven() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Sampler sampler(device, 1000);
+    mcp3221_sample_t sample;
+    device.setBus(sim);
+    sampler.tick();
+    sampler.tick();
+    sampler.tick();
+    CHECK(sampler.poll(sample));                        // latest tick wins
+    CHECK_EQUAL(2, sampler.getJitterStats().missed);
+    CHECK(!sampler.poll(sample));                       // no tick pending
+    sampler.tick();
+    CHECK(sampler.poll(sample));
+    CHECK_EQUAL(2, sampler.getJitterStats().samples);
+}
+
+int main() {
+    RUN_TEST(testFixedRate);
+    RUN_TEST(testMissedDeadlines);
+    RUN_TEST(testFractionalPeriod);
+    RUN_TEST(testWithoutBegin);
+    RUN_TEST(testTimerDriven);
+    return testResult();
+}
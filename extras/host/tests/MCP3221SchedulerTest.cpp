@@ -0,0 +1,310 @@
+/*==============================================================================================================*
+
+    @file     MCP3221SchedulerTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    SHARED-BUS TRANSACTION SCHEDULER TESTS
+ *==============================================================================================================*/
+
+// The simulated MCP3221 shares a bus with an EEPROM model: a write transaction (memory address & data bytes)
+// starts a write cycle during which the EEPROM NACKs its address, so a write job polls it over several steps.
+// The bus logs the address of every transaction, which shows the order in which run() let them through.
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Scheduler.h"
+#include "utility/MCP3221_SimI2C.h"
+
+const byte          TEST_EEPROM_ADDR  = 0x50;
+const unsigned long TEST_WRITE_CYCLE  = 5000;           // EEPROM write cycle (in uS)
+const byte          TEST_LOG_SIZE     =   16;
+
+class SharedBus : public MCP3221_I2C {                 // the simulated MCP3221 & an EEPROM on one bus
+    public:
+        MCP3221_SimI2C adc;
+        byte           data, writes, numLog;
+        byte           log[TEST_LOG_SIZE];
+        SharedBus() : adc(TEST_DEV_ADDR), data(0), writes(0), numLog(0), _addr(0), _len(0), _busyUntil(0) {}
+        void beginTransmission(byte devAddr) {
+            _addr = devAddr;
+            _len = 0;
+            adc.beginTransmission(devAddr);
+        }
+        size_t write(byte value) {
+            if (_addr != TEST_EEPROM_ADDR) return adc.write(value);
+            if (_len++ == 2) data = value;              // two memory address bytes, then the data
+            return 1;
+        }
+        byte endTransmission() {
+            logAddr(_addr);
+            if (_addr != TEST_EEPROM_ADDR) return adc.endTransmission();
+            if ((long)(micros() - _busyUntil) < 0) return 2;   // write cycle in progress
+            if (_len > 2) {
+                writes++;
+                _busyUntil = micros() + TEST_WRITE_CYCLE;
+            }
+            return 0;
+        }
+        byte requestFrom(byte devAddr, byte numBytes) {
+            logAddr(devAddr);
+            return adc.requestFrom(devAddr, numBytes);
+        }
+        int  available() { return adc.available(); }
+        int  read() { return adc.read(); }
+        bool startRequest(byte devAddr, byte numBytes) {
+            logAddr(devAddr);
+            return adc.startRequest(devAddr, numBytes);
+        }
+        bool requestPending() { return adc.requestPending(); }
+    private:
+        byte          _addr, _len;
+        unsigned long _busyUntil;
+        void logAddr(byte addr) { if (numLog < TEST_LOG_SIZE) log[numLog++] = addr; }
+};
+
+typedef struct {
+    byte value;
+    byte step;
+} eeprom_write_t;
+
+static bool eepromWrite(MCP3221_I2C &bus, void *context) {  // one byte to EEPROM address 0x0010
+    eeprom_write_t &write = *(eeprom_write_t*)context;
+    bus.beginTransmission(TEST_EEPROM_ADDR);
+    if (!write.step) {
+        bus.write(0x00);
+        bus.write(0x10);
+        bus.write(write.value);
+        if (bus.endTransmission() == 0) write.step = 1;
+        return false;                                   // poll for the end of the write cycle
+    }
+    return bus.endTransmission() == 0;                  // ACK'ed: write cycle done
+}
+
+static char jobOrder[SCHED_MAX_JOBS + 1];
+static byte numJobOrder = 0;
+
+static bool markJob(MCP3221_I2C&, void *context) {     // records its name, finishes in one step
+    jobOrder[numJobOrder++] = *(const char*)context;
+    jobOrder[numJobOrder] = 0;
+    return true;
+}
+
+typedef struct {
+    sample_status_t status;
+    unsigned int    data;
+    byte            calls;
+} read_result_t;
+
+static void readDone(sample_status_t status, unsigned int data, void *context) {
+    read_result_t &result = *(read_result_t*)context;
+    result.status = status;
+    result.data = data;
+    result.calls++;
+}
+
+static void testPriorityOrder() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221Scheduler sched(sim);
+    numJobOrder = 0;
+    CHECK(!sched.run());                                // nothing queued
+    CHECK(sched.submit(markJob, (void*)"a", SCHED_LOW));
+    CHECK(sched.submit(markJob, (void*)"b", SCHED_NORMAL));
+    CHECK(sched.submit(markJob, (void*)"c", SCHED_HIGH));
+    CHECK(sched.submit(markJob, (void*)"d"));           // default: normal priority
+    CHECK_EQUAL(4, sched.getPending());
+    while (sched.run());
+    CHECK(!strcmp("cbda", jobOrder));                   // highest priority first, oldest first within one
+    CHECK_EQUAL(0, sched.getPending());
+    CHECK(!sched.submit(NULL, NULL));
+    for (byte i=0; i<SCHED_MAX_JOBS; i++) CHECK(sched.submit(markJob, (void*)"e"));
+    CHECK(!sched.submit(markJob, (void*)"f"));          // queue full
+    CHECK_EQUAL(SCHED_MAX_JOBS, sched.getPending());
+}
+
+static void testOverdueFirst() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221Scheduler sched(sim);
+    numJobOrder = 0;
+    sched.setMaxWait(1000);
+    sched.submit(markJob, (void*)"a", SCHED_LOW);
+    advanceClock(500);
+    sched.submit(markJob, (void*)"b", SCHED_LOW);
+    advanceClock(1000);
+    sched.submit(markJob, (void*)"c", SCHED_HIGH);
+    while (sched.run());
+    CHECK(!strcmp("abc", jobOrder));                    // overdue jobs first, the longest-waiting one first
+    const mcp3221_sched_stats_t &low = sched.getStats(SCHED_LOW);
+    CHECK_EQUAL(2, low.jobs);
+    CHECK_NEAR(1500, low.maxDelay, 10);
+    CHECK_NEAR(2500, low.totalDelay, 20);
+    CHECK_EQUAL(1, sched.getStats(SCHED_HIGH).jobs);
+    CHECK_EQUAL(0, sched.getStats(SCHED_NORMAL).jobs);
+    sched.resetStats();
+    CHECK_EQUAL(0, sched.getStats(SCHED_LOW).jobs);
+    CHECK_EQUAL(0, sched.getStats(SCHED_LOW).maxDelay);
+}
+
+static void testReadDeferrals() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221Scheduler sched(sim);
+    numJobOrder = 0;
+    sim.setNonBlocking(true);
+    sim.setLatency(500);
+    sched.submit(markJob, (void*)"a");
+    CHECK(sched.startRequest(TEST_DEV_ADDR, 2));        // split-phase ADC read in flight
+    CHECK_EQUAL(1, sched.getReads());
+    CHECK(!sched.run());
+    CHECK(!sched.run());
+    CHECK_EQUAL(2, sched.getReadDeferrals());
+    CHECK_EQUAL(1, sched.getPending());
+    advanceClock(500);
+    CHECK(sched.run());                                 // read complete: the job runs
+    CHECK_EQUAL(2, sched.getReadDeferrals());
+    CHECK_EQUAL(0, sched.getPending());
+}
+
+static void testDeadlineDeferrals() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Sampler sampler(device, 500);                // a read every 2000uS
+    MCP3221Scheduler sched(sim);
+    numJobOrder = 0;
+    device.setBus(sched);
+    CHECK(sched.addSampler(sampler));
+    sampler.begin();
+    sched.submit(markJob, (void*)"a", SCHED_HIGH, 5000);   // longer than a sampling period
+    CHECK(!sched.run());
+    CHECK_EQUAL(1, sched.getDeadlineDeferrals());
+    sched.submit(markJob, (void*)"b", SCHED_LOW, 1000);
+    CHECK(sched.run());                                 // fits before the deadline, despite its priority
+    CHECK(!strcmp("b", jobOrder));
+    CHECK(!sched.run());
+    CHECK_EQUAL(2, sched.getDeadlineDeferrals());
+    advanceClock(SCHED_MAX_WAIT);
+    CHECK(sched.run());                                 // overdue: runs regardless of the deadline
+    CHECK(!strcmp("ba", jobOrder));
+    CHECK_EQUAL(2, sched.getDeadlineDeferrals());
+}
+
+static void testUnstartedSampler() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Sampler sampler(device, 500);                // a read every 2000uS, schedule not started yet
+    MCP3221Scheduler sched(sim);
+    numJobOrder = 0;
+    device.setBus(sched);
+    CHECK(sched.addSampler(sampler));
+    advanceClock(10000);
+    CHECK_NEAR(micros() + 2000, sampler.getDeadline(), 10);
+    sched.submit(markJob, (void*)"a", SCHED_NORMAL, 1000);
+    CHECK(sched.run());                                 // runs right away rather than after SCHED_MAX_WAIT
+    CHECK(!strcmp("a", jobOrder));
+    CHECK_EQUAL(0, sched.getDeadlineDeferrals());
+    sched.submit(markJob, (void*)"b", SCHED_NORMAL, 5000);
+    CHECK(!sched.run());                                // still held if longer than a sampling period
+    CHECK_EQUAL(1, sched.getDeadlineDeferrals());
+}
+
+static void testWriteJob() {
+    SharedBus bus;
+    MCP3221Scheduler sched(bus);
+    eeprom_write_t write = { 0xA5, 0 };
+    CHECK(sched.submit(eepromWrite, &write));
+    CHECK(sched.run());                                 // write transaction: the write cycle starts
+    CHECK_EQUAL(1, bus.writes);
+    CHECK_EQUAL(0xA5, bus.data);
+    CHECK(sched.run());                                 // polled: still busy
+    CHECK_EQUAL(1, sched.getPending());
+    advanceClock(TEST_WRITE_CYCLE);
+    CHECK(sched.run());                                 // polled: done
+    CHECK_EQUAL(0, sched.getPending());
+    CHECK_EQUAL(1, bus.writes);
+    CHECK_EQUAL(1, sched.getStats(SCHED_NORMAL).jobs);  // counted once, at its first step
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    sim.beginTransmission(TEST_DEV_ADDR);
+    for (byte i=0; i<SIM_BUFFER_SIZE; i++) CHECK_EQUAL(1, sim.write(i));
+    CHECK_EQUAL(0, sim.write(0));                       // transmit buffer full
+    CHECK_EQUAL(0, sim.endTransmission());
+}
+
+static void testQueuedReadContends() {
+    SharedBus bus;
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221Scheduler sched(bus);
+    eeprom_write_t write = { 0x5A, 0 };
+    read_result_t result = { SAMPLE_FAILED, 0, 0 };
+    bus.adc.setWaveform(SIM_CONSTANT, 1234);
+    device.setBus(sched);
+    sched.submit(eepromWrite, &write, SCHED_LOW);
+    CHECK(!sched.submitRead(device, NULL, NULL));
+    CHECK(sched.submitRead(device, readDone, &result)); // default: high priority
+    CHECK_EQUAL(2, sched.getPending());
+    CHECK(sched.run());                                 // the read goes first...
+    CHECK_EQUAL(1, result.calls);
+    CHECK_EQUAL(SAMPLE_VALID, result.status);
+    CHECK_EQUAL(1234, result.data);
+    CHECK_EQUAL(1, sched.getReads());
+    CHECK(sched.run());                                 // ...then the EEPROM write
+    CHECK_EQUAL(2, bus.numLog);
+    CHECK_EQUAL(TEST_DEV_ADDR, bus.log[0]);
+    CHECK_EQUAL(TEST_EEPROM_ADDR, bus.log[1]);
+    CHECK(sched.submitRead(device, readDone, &result));
+    CHECK(sched.run());                                 // a read fits between two steps of the write job
+    CHECK_EQUAL(2, result.calls);
+    CHECK_EQUAL(TEST_DEV_ADDR, bus.log[2]);
+    CHECK_EQUAL(1, sched.getPending());
+    sched.setMaxWait(1000);
+    advanceClock(1000);
+    CHECK(sched.submitRead(device, readDone, &result));
+    CHECK(sched.run());                                 // overdue write job beats the fresh read
+    CHECK_EQUAL(TEST_EEPROM_ADDR, bus.log[3]);
+    CHECK_EQUAL(2, result.calls);
+    CHECK(sched.run());
+    CHECK_EQUAL(3, result.calls);
+    CHECK_EQUAL(3, sched.getStats(SCHED_HIGH).jobs);
+    unsigned int data;
+    CHECK_EQUAL(SAMPLE_VALID, device.readData(data));   // direct reads still pass straight through
+    CHECK_EQUAL(4, sched.getReads());
+}
+
+int main() {
+    RUN_TEST(testPriorityOrder);
+    RUN_TEST(testOverdueFirst);
+    RUN_TEST(testReadDeferrals);
+    RUN_TEST(testDeadlineDeferrals);
+    RUN_TEST(testUnstartedSampler);
+    RUN_TEST(testWriteJob);
+    RUN_TEST(testQueuedReadContends);
+    return testResult();
+}
@@ -0,0 +1,183 @@
+/*==============================================================================================================*
+
+    @file     MCP3221SmoothingTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    BUILT-IN SMOOTHING (EMAVG / ROLLING-AVERAGE / MEDIAN) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void testNoSmoothing() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    sim.setWaveform(SIM_CONSTANT, 1234);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    for (byte i=0; i<5; i++) CHECK_EQUAL(1234, device.getData());
+    CHECK_EQUAL(SAMPLE_VALID, device.getSampleStatus());
+}
+
+static void testEmaStep() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR, DEFAULT_VREF, DEFAULT_RES_1, DEFAULT_RES_2, 128);    // half a step per sample
+    sim.setWaveform(SIM_CONSTANT, 1000);
+    device.setBus(sim);
+    CHECK_EQUAL(1000, device.getData());                // the first sample seeds the average
+    sim.setWaveform(SIM_CONSTANT, 3000);
+    CHECK_EQUAL(2000, device.getData());
+    CHECK_EQUAL(2500, device.getData());
+    CHECK_EQUAL(2750, device.getData());
+}
+
+static void checkEmaMatchesCore(unsigned int alpha) {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR), refSim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221_EmaCore ema;
+    sim.setWaveform(SIM_SINE, 2048, 1500, 50);
+    sim.setNoise(20);
+    refSim.setWaveform(SIM_SINE, 2048, 1500, 50);
+    refSim.setNoise(20);                                // same noise sequence as 'sim'
+    device.setBus(sim);
+    device.setAlpha(alpha);
+    ema.setAlpha(alpha);
+    ema.reset();
+    for (unsigned int i=0; i<200; i++) {
+        refSim.requestFrom(TEST_DEV_ADDR, DATA_BYTES);
+        uint16_t raw = refSim.read() << 8;
+        raw |= refSim.read();
+        CHECK_EQUAL(ema.update(raw), device.getData());
+    }
+}
+
+static void testEmaMatchesCore() {
+    checkEmaMatchesCore(DEFAULT_ALPHA);                 // multiply path
+    checkEmaMatchesCore(64);                            // shift path
+}
+
+static void testEmaTracksSlowly() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    sim.setWaveform(SIM_CONSTANT, 2000);
+    sim.setNoise(100);
+    device.setBus(sim);
+    device.setAlpha(8);
+    unsigned int data = 0;
+    for (unsigned int i=0; i<500; i++) data = device.getData();
+    CHECK_NEAR(2000, data, 30);                         // noise of +/- 100 counts mostly averaged out
+}
+
+static void testRollingAverage() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    uint16_t samples[MAX_NUM_SAMPLES];
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);             // 0, 100, 200 ... 3900
+    device.setBus(sim);
+    device.setSampleBuffer(samples, MAX_NUM_SAMPLES);
+    device.setSmoothing(ROLLING_AVG);
+    device.setNumSamples(4);                            // power of two: divides by shift
+    const unsigned int expected[] = { 0, 50, 100, 150, 250, 350, 450 };
+    for (byte i=0; i<7; i++) CHECK_EQUAL(expected[i], device.getData());
+    device.setNumSamples(3);                            // restarts the window
+    CHECK_EQUAL(700, device.getData());
+    CHECK_EQUAL(750, device.getData());
+    CHECK_EQUAL(800, device.getData());
+    CHECK_EQUAL(900, device.getData());
+}
+
+static void testMedian() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    uint16_t samples[MAX_MEDIAN_WINDOW];
+    sim.setWaveform(SIM_SQUARE, 1000, 1000, 10);        // 5 x 1000, 5 x 2000
+    device.setBus(sim);
+    device.setSampleBuffer(samples, MAX_MEDIAN_WINDOW);
+    device.setSmoothing(MEDIAN);
+    device.setNumSamples(5);
+    for (byte i=0; i<7; i++) CHECK_EQUAL(1000, device.getData());
+    CHECK_EQUAL(2000, device.getData());                // the step passes once it holds half the window
+}
+
+static void testDefaultWindow() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR, DEFAULT_VREF, DEFAULT_RES_1, DEFAULT_RES_2, DEFAULT_ALPHA, VOLTAGE_INPUT_5V,
+                   ROLLING_AVG, MAX_NUM_SAMPLES);       // picked in the constructor, no sample buffer given
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);
+    device.setBus(sim);
+    for (byte i=0; i<MAX_NUM_SAMPLES; i++) device.getData();
+    CHECK_EQUAL(1650, device.getData());                // mean of 100 ... 3200: the full window is kept
+    device.setSmoothing(MEDIAN);
+    device.setNumSamples(3);
+    CHECK_EQUAL(3300, device.getData());
+    CHECK_EQUAL(3400, device.getData());
+    CHECK_EQUAL(3400, device.getData());                // median of 3300, 3400 & 3500
+}
+
+static void testSampleBuffer() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    uint16_t samples[2];
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);
+    device.setBus(sim);
+    device.setSmoothing(ROLLING_AVG);
+    device.setNumSamples(4);
+    device.setSampleBuffer(samples, 2);                 // the window is limited to the buffer
+    CHECK_EQUAL(0, device.getData());
+    CHECK_EQUAL(50, device.getData());
+    CHECK_EQUAL(150, device.getData());
+    device.setSmoothing(MEDIAN);                        // an even buffer holds an odd window one shorter
+    CHECK_EQUAL(300, device.getData());
+    CHECK_EQUAL(400, device.getData());
+    device.setSampleBuffer(NULL, 0);                    // back to the device's own window
+    device.setSmoothing(ROLLING_AVG);
+    CHECK_EQUAL(500, device.getData());
+    CHECK_EQUAL(550, device.getData());
+    CHECK_EQUAL(600, device.getData());
+    CHECK_EQUAL(650, device.getData());
+    CHECK_EQUAL(750, device.getData());                 // four samples again
+}
+
+int main() {
+    RUN_TEST(testNoSmoothing);
+    RUN_TEST(testEmaStep);
+    RUN_TEST(testEmaMatchesCore);
+    RUN_TEST(testEmaTracksSlowly);
+    RUN_TEST(testRollingAverage);
+    RUN_TEST(testMedian);
+    RUN_TEST(testDefaultWindow);
+    RUN_TEST(testSampleBuffer);
+    return testResult();
+}
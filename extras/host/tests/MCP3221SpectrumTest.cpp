@@ -0,0 +1,152 @@
+/*==============================================================================================================*
+
+    @file     MCP3221SpectrumTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    SPECTRUM TESTS (FIXED-POINT FFT & GOERTZEL BANK)
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Spectrum.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void readWave(uint16_t *samples, unsigned int count, sim_waveform_t wave, unsigned int amplitude,
+                     unsigned int period) {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    sim.setWaveform(wave, (wave == SIM_SINE) ? 2048 : 1000, amplitude, period);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    CHECK_EQUAL(count, device.readBurst(samples, count));
+}
+
+static void testFFTSine() {
+    MCP3221FFT<64> fft;
+    uint16_t samples[64];
+    readWave(samples, 64, SIM_SINE, 1000, 8);           // 8 cycles per block
+    fft.setSampleRate(8000);
+    fft.analyze(samples);
+    CHECK_EQUAL(64, fft.getSize());
+    CHECK_EQUAL(8, fft.getPeakBin());
+    CHECK_EQUAL(1000, fft.getFrequency(8));
+    CHECK_NEAR(1000, fft.getMagnitude(8), 20);
+    CHECK(fft.getMagnitude(0) <= 2);                    // mean removed
+    for (unsigned int bin=1; bin<=32; bin++) {
+        if (bin != 8) CHECK(fft.getMagnitude(bin) <= 20);
+    }
+    CHECK_EQUAL(0, fft.getMagnitude(33));
+}
+
+static void testFFTSquare() {
+    MCP3221FFT<128> fft;
+    uint16_t samples[128];
+    readWave(samples, 128, SIM_SQUARE, 1200, 16);       // odd harmonics at 1/n of 4/pi x 600
+    fft.analyze(samples);
+    CHECK_EQUAL(8, fft.getPeakBin());
+    CHECK_NEAR(764, fft.getMagnitude(8), 40);
+    CHECK_NEAR(255, fft.getMagnitude(24), 40);
+    CHECK(fft.getMagnitude(16) <= 20);                  // no even harmonics
+}
+
+static void testFFTSizes() {
+    MCP3221FFT<8> small;
+    MCP3221FFT<256> large;
+    uint16_t samples[256];
+    readWave(samples, 256, SIM_SINE, 500, 32);
+    small.analyze(samples);                             // one quarter cycle: mostly low bins
+    large.analyze(samples);
+    CHECK_EQUAL(8, large.getPeakBin());
+    CHECK_NEAR(500, large.getMagnitude(8), 15);
+    CHECK(small.getPeakBin() <= 2);
+}
+
+static void testGoertzel() {
+    MCP3221Goertzel goertzel(8000);
+    uint16_t samples[64];
+    CHECK(goertzel.addFrequency(1000));
+    CHECK(goertzel.addFrequency(2500));
+    CHECK(!goertzel.addFrequency(4500));                // above Nyquist
+    CHECK_EQUAL(2, goertzel.getNumBins());
+    CHECK_EQUAL(2500, goertzel.getFrequency(1));
+    readWave(samples, 64, SIM_SINE, 1000, 8);           // 1000Hz at 8000 samples/S
+    goertzel.analyze(samples, 64);
+    CHECK_NEAR(1000, goertzel.getAmplitude(0), 20);
+    CHECK(goertzel.getAmplitude(1) <= 20);
+    goertzel.setSampleRate(4000);                       // the same samples now hold a 500Hz tone
+    goertzel.analyze(samples, 64);
+    CHECK(goertzel.getAmplitude(0) <= 20);
+    goertzel.clear();
+    CHECK_EQUAL(0, goertzel.getNumBins());
+    for (byte i=0; i<MAX_GOERTZEL_BINS; i++) CHECK(goertzel.addFrequency(100 + i * 100));
+    CHECK(!goertzel.addFrequency(1000));                // bank full
+}
+
+static void testGoertzelMatchesFFT() {
+    MCP3221FFT<128> fft;
+    MCP3221Goertzel goertzel(12800);
+    uint16_t samples[128];
+    readWave(samples, 128, SIM_TRIANGLE, 2000, 32);
+    fft.setSampleRate(12800);
+    fft.analyze(samples);
+    for (unsigned int bin=4; bin<=20; bin+=4) goertzel.addFrequency(fft.getFrequency(bin));
+    goertzel.analyze(samples, 128);
+    for (byte i=0; i<goertzel.getNumBins(); i++) CHECK_NEAR(fft.getMagnitude(4 * (i + 1)), goertzel.getAmplitude(i), 8);
+}
+
+static void testGoertzelNegativeCoefficient() {
+    MCP3221Goertzel goertzel(9000);
+    uint16_t samples[66];
+    readWave(samples, 66, SIM_SINE, 1000, 3);           // 3000Hz: coefficient 2cos(2pi/3) = -1
+    CHECK(goertzel.addFrequency(3000));
+    CHECK(goertzel.addFrequency(4000));                 // coefficient -1.88
+    CHECK(goertzel.addFrequency(1000));
+    goertzel.analyze(samples, 66);
+    CHECK_NEAR(1000, goertzel.getAmplitude(0), 20);
+    CHECK(goertzel.getAmplitude(1) <= 60);
+    CHECK(goertzel.getAmplitude(2) <= 20);
+    for (byte i=0; i<66; i++) samples[i] = 4095 - samples[i];    // inverted: same amplitude
+    goertzel.analyze(samples, 66);
+    CHECK_NEAR(1000, goertzel.getAmplitude(0), 20);
+}
+
+int main() {
+    RUN_TEST(testFFTSine);
+    RUN_TEST(testFFTSquare);
+    RUN_TEST(testFFTSizes);
+    RUN_TEST(testGoertzel);
+    RUN_TEST(testGoertzelMatchesFFT);
+    RUN_TEST(testGoertzelNegativeCoefficient);
+    return testResult();
+}
@@ -0,0 +1,142 @@
+/*==============================================================================================================*
+
+    @file     MCP3221StatsTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    WINDOWED STATISTICS (MCP3221TumblingStats / MCP3221SlidingStats) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221Stats.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static const uint16_t values[] = { 2, 4, 4, 4, 5, 5, 7, 9 };    // mean 5, standard deviation 2, RMS sqrt(29)
+
+static void testIsqrt() {
+    CHECK_EQUAL(0, MCP3221_isqrt(0));
+    CHECK_EQUAL(1, MCP3221_isqrt(3));
+    CHECK_EQUAL(2, MCP3221_isqrt(4));
+    CHECK_EQUAL(65535, MCP3221_isqrt(4294967295ULL));
+    CHECK_EQUAL(4294967295UL, MCP3221_isqrt(0xFFFFFFFFFFFFFFFFULL));
+}
+
+static void testComputeStats() {
+    MCP3221TumblingStats stats(8);
+    mcp3221_window_stats_t result;
+    uint16_t block[8];
+    memcpy(block, values, sizeof(block));
+    CHECK(!stats.getStats(result));                     // no complete window yet
+    CHECK_EQUAL(8, stats.processBlock(block, 8));
+    CHECK_EQUAL(0, memcmp(block, values, sizeof(block)));   // pass-through: samples untouched
+    CHECK(stats.getStats(result));
+    CHECK_EQUAL(8, result.count);
+    CHECK_EQUAL(2, result.min);
+    CHECK_EQUAL(9, result.max);
+    CHECK_EQUAL(5 << STATS_FRAC_BITS, result.mean);
+    CHECK_EQUAL(2 << STATS_FRAC_BITS, result.stdDev);
+    CHECK_EQUAL(86, result.rms);                        // sqrt(29) = 5.385 -> 86.16 sixteenths
+}
+
+static void testTumblingWindows() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    MCP3221TumblingStats stats(4);
+    mcp3221_window_stats_t result;
+    sim.setWaveform(SIM_RAMP, 0, 4000, 40);             // 0, 100, 200 ... 3900
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    device.addStage(stats);
+    for (byte i=0; i<3; i++) device.getData();
+    CHECK(!stats.available());
+    device.getData();
+    CHECK(stats.available());
+    for (byte i=0; i<2; i++) device.getData();          // half of the next window: the latched one stays
+    CHECK(stats.getStats(result));
+    CHECK(!stats.available());
+    CHECK_EQUAL(0, result.min);
+    CHECK_EQUAL(300, result.max);
+    CHECK_EQUAL(150 << STATS_FRAC_BITS, result.mean);
+    uint16_t burst[6];
+    device.readBurst(burst, 6);                         // blocks are accumulated in place
+    CHECK_EQUAL(3, stats.getWindows());
+    CHECK(stats.getStats(result));
+    CHECK_EQUAL(800, result.min);
+    CHECK_EQUAL(1100, result.max);
+    stats.reset();
+    CHECK_EQUAL(0, stats.getWindows());
+    CHECK(!stats.getStats(result));
+}
+
+static void testSlidingWindow() {
+    MCP3221SlidingStats<4> stats;
+    mcp3221_window_stats_t result;
+    const uint16_t input[] = { 10, 50, 20, 30, 40, 35, 36 };
+    for (byte i=0; i<7; i++) {
+        unsigned int sample = input[i];
+        CHECK(stats.process(sample));
+        CHECK_EQUAL(input[i], sample);
+    }
+    stats.getStats(result);                             // window: 30, 40, 35, 36
+    CHECK_EQUAL(4, result.count);
+    CHECK_EQUAL(30, result.min);                        // 10 & 50 left the window: rescanned
+    CHECK_EQUAL(40, result.max);
+    CHECK_EQUAL((141 << STATS_FRAC_BITS) / 4, result.mean);
+    stats.reset();
+    stats.getStats(result);
+    CHECK_EQUAL(0, result.count);
+    CHECK_EQUAL(0, result.mean);
+}
+
+static void testFullScaleWindow() {
+    MCP3221TumblingStats stats(1000);
+    mcp3221_window_stats_t result;
+    for (unsigned int i=0; i<1000; i++) {
+        unsigned int sample = 4095;
+        stats.process(sample);
+    }
+    CHECK(stats.getStats(result));
+    CHECK_EQUAL(65520, result.mean);                    // 4095 in sixteenths: no overflow
+    CHECK_EQUAL(65520, result.rms);
+    CHECK_EQUAL(0, result.stdDev);
+}
+
+int main() {
+    RUN_TEST(testIsqrt);
+    RUN_TEST(testComputeStats);
+    RUN_TEST(testTumblingWindows);
+    RUN_TEST(testSlidingWindow);
+    RUN_TEST(testFullScaleWindow);
+    return testResult();
+}
@@ -0,0 +1,123 @@
+/*==============================================================================================================*
+
+    @file     MCP3221StrTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    PRINTABLE INFO & I2C STATUS STRINGS (MCP3221InfoStr() / MCP3221ComStr()) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221InfoStr.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static void testInfoStr() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    MCP3221_PString str = MCP3221InfoStr(device);       // one-argument form: shared static buffer
+    CHECK(strstr(str, "I2C ADDRESS:\t   77 (0X4D)") != NULL);
+    CHECK(strstr(str, "CONNECTED") != NULL);
+    CHECK(strstr(str, "SAMPLES BUFFER:\t   10 SAMPLES\n") != NULL);
+    CHECK(str.length() < (size_t)(INFO_BUFFER_SIZE - 1));
+    char buffer[INFO_BUFFER_SIZE];
+    MCP3221_PString copy = MCP3221InfoStr(device, buffer, sizeof(buffer));
+    CHECK_EQUAL(0, strcmp(copy, str));
+    CHECK((const char *)MCP3221InfoStr(device) == (const char *)str);     // same buffer on every call
+}
+
+static void testInfoStrNotConnected() {
+    MCP3221_SimI2C sim(0x48);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    const char *str = MCP3221InfoStr(device);
+    CHECK(strstr(str, "NOT CONNECTED") != NULL);
+    CHECK(strstr(str, "Error Code #2: Address sent, NACK received\n") != NULL);
+    CHECK(strstr(str, "VOLTAGE REFERENCE") == NULL);
+}
+
+static void testInfoStrUnknownSmoothing() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    device.setSmoothing((smoothing_t)9);                // out of range: must not index past the table
+    CHECK(strstr(MCP3221InfoStr(device), "SMOOTHING METHOD:  UNKNOWN") != NULL);
+    device.setSmoothing(MEDIAN);
+    CHECK(strstr(MCP3221InfoStr(device), "SMOOTHING METHOD:  MEDIAN") != NULL);
+}
+
+static void testInfoStrTruncated() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    char small[20];
+    memset(small, 'x', sizeof(small));
+    MCP3221_PString str = MCP3221InfoStr(device, small, 16);
+    CHECK_EQUAL(15, str.length());                      // truncated, still terminated
+    CHECK_EQUAL('\0', small[15]);
+    CHECK_EQUAL('x', small[16]);                        // nothing written past the given size
+    CHECK_EQUAL(0, strncmp(small, MCP3221InfoStr(device), 15));
+}
+
+static void testComStr() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    device.ping();
+    CHECK_EQUAL(0, strcmp(MCP3221ComStr(device), "Success"));
+    sim.setNackEvery(1);
+    device.ping();
+    CHECK_EQUAL(0, strcmp(MCP3221ComStr(device), "Error Code #2: Address sent, NACK received"));
+    char small[10];
+    MCP3221_PString str = MCP3221ComStr(device, small, sizeof(small));
+    CHECK_EQUAL(sizeof(small) - 1, str.length());
+    CHECK_EQUAL(0, strcmp(small, "Error Cod"));
+}
+
+static void testUnlistedComCode() {
+    char buffer[COM_BUFFER_SIZE];
+    MCP3221_PString str(buffer, sizeof(buffer));
+    MCP3221PrintComCode(str, 9);
+    CHECK_EQUAL(0, strcmp(buffer, "Error Code #9: Unlisted error"));
+}
+
+int main() {
+    RUN_TEST(testInfoStr);
+    RUN_TEST(testInfoStrNotConnected);
+    RUN_TEST(testInfoStrUnknownSmoothing);
+    RUN_TEST(testInfoStrTruncated);
+    RUN_TEST(testComStr);
+    RUN_TEST(testUnlistedComCode);
+    return testResult();
+}
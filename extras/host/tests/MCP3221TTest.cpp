@@ -0,0 +1,136 @@
+/*==============================================================================================================*
+
+    @file     MCP3221TTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    COMPILE-TIME CONFIGURED DRIVER (MCP3221T) TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221T.h"
+#include "utility/MCP3221_SimI2C.h"
+
+typedef MCP3221T<TEST_DEV_ADDR, NO_SMOOTHING, 1, VOLTAGE_INPUT_5V, DEFAULT_VREF, DEFAULT_RES_1, DEFAULT_RES_2,
+                 MCP3221_SimI2C> RawAdc;
+typedef MCP3221T<TEST_DEV_ADDR, ROLLING_AVG, 4, VOLTAGE_INPUT_5V, DEFAULT_VREF, DEFAULT_RES_1, DEFAULT_RES_2,
+                 MCP3221_SimI2C> AverageAdc;
+typedef MCP3221T<TEST_DEV_ADDR, EMAVG, 2, VOLTAGE_INPUT_5V, DEFAULT_VREF, DEFAULT_RES_1, DEFAULT_RES_2,
+                 MCP3221_SimI2C> EmaAdc;
+typedef MCP3221T<TEST_DEV_ADDR, MEDIAN, 3, VOLTAGE_INPUT_5V, DEFAULT_VREF, DEFAULT_RES_1, DEFAULT_RES_2,
+                 MCP3221_SimI2C> MedianAdc;
+typedef MCP3221T<TEST_DEV_ADDR, NO_SMOOTHING, 1, VOLTAGE_INPUT_12V, DEFAULT_VREF, DEFAULT_RES_1, DEFAULT_RES_2,
+                 MCP3221_SimI2C> RailAdc;
+
+static_assert(sizeof(RawAdc) < sizeof(MCP3221), "MCP3221T without smoothing must be smaller than MCP3221");
+static_assert(sizeof(AverageAdc) < sizeof(MCP3221), "MCP3221T with a 4-sample window must be smaller than MCP3221");
+static_assert(sizeof(MedianAdc) < sizeof(MCP3221), "MCP3221T with a 3-sample median must be smaller than MCP3221");
+
+static void testSize() {
+    CHECK(sizeof(RawAdc) <= sizeof(void *) + 2 * sizeof(unsigned int));    // bus reference, result code & value
+    CHECK(sizeof(AverageAdc) <= sizeof(RawAdc) + 4 * sizeof(uint16_t) + 2 + sizeof(unsigned long) + sizeof(void *));
+    CHECK(sizeof(EmaAdc) < sizeof(AverageAdc));
+}
+
+static void testRawReadsMatchRuntimeDriver() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR), runtimeSim(TEST_DEV_ADDR);
+    RawAdc adc(sim);
+    MCP3221 device(TEST_DEV_ADDR);
+    sim.setWaveform(SIM_RAMP, 100, 3000, 30);
+    runtimeSim.setWaveform(SIM_RAMP, 100, 3000, 30);
+    device.setBus(runtimeSim);
+    device.setSmoothing(NO_SMOOTHING);
+    CHECK_EQUAL(COM_SUCCESS, adc.ping());
+    for (byte i=0; i<40; i++) CHECK_EQUAL(device.getData(), adc.getData());
+    CHECK_EQUAL(device.getVoltage(), adc.getVoltage());
+}
+
+static void testRollingAverage() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    AverageAdc adc(sim);
+    sim.setWaveform(SIM_RAMP, 0, 800, 8);               // 0, 100 ... 700
+    CHECK_EQUAL(0, adc.getData());
+    CHECK_EQUAL(50, adc.getData());                     // window still filling
+    CHECK_EQUAL(100, adc.getData());
+    CHECK_EQUAL(150, adc.getData());
+    CHECK_EQUAL(250, adc.getData());                    // 100 ... 400
+    adc.resetFilter();
+    CHECK_EQUAL(500, adc.getData());                    // restarts the window
+}
+
+static void testEmaAndMedian() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    EmaAdc ema(sim);
+    MedianAdc median(sim);
+    sim.setWaveform(SIM_CONSTANT, 1000);
+    CHECK_EQUAL(1000, ema.getData());                   // the first sample seeds the average
+    sim.setWaveform(SIM_CONSTANT, 3000);
+    CHECK_EQUAL(2000, ema.getData());                   // alpha = 1/2
+    CHECK_EQUAL(2500, ema.getData());
+    sim.setWaveform(SIM_SQUARE, 1000, 3000, 3);         // 1000, 4000, 4000 ...
+    CHECK_EQUAL(1000, median.getData());
+    CHECK_EQUAL(4000, median.getData());                // 1000, 4000: upper middle
+    CHECK_EQUAL(4000, median.getData());
+    CHECK_EQUAL(4000, median.getData());                // the lone 1000 is rejected
+}
+
+static void testVoltageDivider() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    RailAdc rail(sim);
+    sim.setWaveform(SIM_CONSTANT, 2048);
+    CHECK_NEAR(2048UL * (DEFAULT_RES_1 + DEFAULT_RES_2) / DEFAULT_RES_2, rail.getVoltage(), 1);
+}
+
+static void testFailedReadHoldsValue() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    RawAdc adc(sim);
+    sim.setWaveform(SIM_CONSTANT, 1500);
+    CHECK_EQUAL(1500, adc.getData());
+    sim.setWaveform(SIM_CONSTANT, 2500);
+    sim.setNackEvery(1);
+    unsigned long transactions = sim.getTransactions();
+    CHECK_EQUAL(1500, adc.getData());                   // no retries: the last value is held
+    CHECK_EQUAL(2, sim.getTransactions() - transactions);   // the read & one ping
+    CHECK(adc.getComResult() != COM_SUCCESS);
+}
+
+int main() {
+    RUN_TEST(testSize);
+    RUN_TEST(testRawReadsMatchRuntimeDriver);
+    RUN_TEST(testRollingAverage);
+    RUN_TEST(testEmaAndMedian);
+    RUN_TEST(testVoltageDivider);
+    RUN_TEST(testFailedReadHoldsValue);
+    return testResult();
+}
@@ -0,0 +1,99 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Test.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    MINIMAL TEST HARNESS FOR THE HOST REGRESSION TESTS (NO DEPENDENCIES BEYOND THE C LIBRARY)
+ *==============================================================================================================*
+
+    Each test file defines its tests as plain functions and runs them from main() with RUN_TEST(), returning
+    testResult(). A failed check prints its location & values and marks the test as failed, but the test goes
+    on, so a single run reports every failing check. CTest treats a non-zero exit code as a failure.
+
+ *==============================================================================================================*/
+
+#ifndef MCP3221Test_h
+#define MCP3221Test_h
+
+#include <stdio.h>
+#include "Arduino.h"
+
+const byte TEST_DEV_ADDR = 0x4D;                        // I2C address of the simulated devices
+
+static unsigned int testChecks = 0, testFailures = 0, testsFailed = 0;
+
+static inline void checkFailed(const char *file, int line, const char *expr) {
+    printf("  FAILED  %s:%d: %s\n", file, line, expr);
+    testFailures++;
+}
+
+static inline void checkTrue(bool result, const char *expr, const char *file, int line) {
+    testChecks++;
+    if (!result) checkFailed(file, line, expr);
+}
+
+static inline void checkEqual(long long expected, long long actual, const char *expr, const char *file, int line) {
+    testChecks++;
+    if (expected == actual) return;
+    checkFailed(file, line, expr);
+    printf("          expected %lld, got %lld\n", expected, actual);
+}
+
+static inline void checkNear(long long expected, long long actual, long long tolerance, const char *expr,
+                             const char *file, int line) {
+    testChecks++;
+    if ((actual >= expected - tolerance) && (actual <= expected + tolerance)) return;
+    checkFailed(file, line, expr);
+    printf("          expected %lld (+/- %lld), got %lld\n", expected, tolerance, actual);
+}
+
+static inline void runTest(void (*test)(), const char *name) {
+    unsigned int failures = testFailures;
+    setSimulatedClock(true);                            // every test starts at 0uS on a clock it controls
+    test();
+    if (testFailures != failures) testsFailed++;
+    printf("%s  %s\n", (testFailures == failures) ? "ok    " : "FAILED", name);
+}
+
+static inline int testResult() {
+    printf("%u checks, %u failed (%u tests)\n", testChecks, testFailures, testsFailed);
+    return testFailures ? 1 : 0;
+}
+
+#define CHECK(expr)                           checkTrue((expr), #expr, __FILE__, __LINE__)
+#define CHECK_EQUAL(expected, actual)         checkEqual((expected), (actual), #actual, __FILE__, __LINE__)
+#define CHECK_NEAR(expected, actual, tol)     checkNear((expected), (actual), (tol), #actual, __FILE__, __LINE__)
+#define RUN_TEST(test)                        runTest(test, #test)
+
+#endif
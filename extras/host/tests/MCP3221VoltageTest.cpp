@@ -0,0 +1,144 @@
+/*==============================================================================================================*
+
+    @file     MCP3221VoltageTest.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    FIXED-POINT VOLTAGE CONVERSION & VOLTAGE LOOK-UP TABLE TESTS
+ *==============================================================================================================*/
+
+#include "MCP3221Test.h"
+#include "MCP3221.h"
+#include "utility/MCP3221_SimI2C.h"
+
+static uint16_t fullLut[LUT_SIZE_4096];
+static uint16_t shortLut[LUT_SIZE_256];
+
+static unsigned int voltageAt(MCP3221_SimI2C &sim, MCP3221 &device, unsigned int data) {
+    sim.setWaveform(SIM_CONSTANT, data);
+    return device.getVoltage();
+}
+
+static void check5V(unsigned int vRef) {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR, vRef);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    for (unsigned int data=0; data<=4095; data+=13) {
+        CHECK_EQUAL(lround((double)data * vRef / 4096), voltageAt(sim, device, data));
+    }
+}
+
+static void test5V() {
+    check5V(DEFAULT_VREF);                              // 1mV per count
+    check5V(MIN_VREF);
+    check5V(5000);
+    check5V(MAX_VREF);
+}
+
+static void checkDivider(unsigned int res1, unsigned int res2) {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR, DEFAULT_VREF, res1, res2, DEFAULT_ALPHA, VOLTAGE_INPUT_12V, NO_SMOOTHING);
+    device.setBus(sim);
+    for (unsigned int data=0; data<=4095; data+=13) {
+        CHECK_NEAR(lround((double)data * (res1 + res2) / res2), voltageAt(sim, device, data), 1);
+    }
+}
+
+static void test12V() {
+    checkDivider(DEFAULT_RES_1, DEFAULT_RES_2);         // 10K / 4K7
+    checkDivider(22000, 10000);
+    checkDivider(1000, 1000);
+}
+
+static void testSettingsUpdateScale() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    CHECK_EQUAL(2048, voltageAt(sim, device, 2048));
+    device.setVref(5000);
+    CHECK_EQUAL(2500, voltageAt(sim, device, 2048));
+    device.setVinput(VOLTAGE_INPUT_12V);                // default divider: 10K / 4K7
+    CHECK_NEAR(6405, voltageAt(sim, device, 2048), 1);
+    device.setRes2(10000);
+    CHECK_EQUAL(4096, voltageAt(sim, device, 2048));
+}
+
+static void testLUT() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    device.setSmoothing(NO_SMOOTHING);
+    for (unsigned int i=0; i<LUT_SIZE_4096; i++) fullLut[i] = 3 * i;
+    for (unsigned int i=0; i<LUT_SIZE_256; i++) shortLut[i] = 48 * i;
+    device.setVoltageLUT(fullLut, LUT_SIZE_4096);
+    CHECK_EQUAL(3003, voltageAt(sim, device, 1001));
+    CHECK_EQUAL(12285, voltageAt(sim, device, 4095));
+    device.setVoltageLUT(shortLut, LUT_SIZE_256);       // every 16th code, interpolated
+    CHECK_EQUAL(3003, voltageAt(sim, device, 1001));
+    CHECK_EQUAL(12285, voltageAt(sim, device, 4095));   // last segment extrapolated
+    device.setVoltageLUT(shortLut, 100);                // unsupported size: back to the precomputed scale
+    CHECK_EQUAL(1001, voltageAt(sim, device, 1001));
+}
+
+static void testVoltageToData() {
+    MCP3221 device(TEST_DEV_ADDR, 5000);
+    for (unsigned int mV=0; mV<=5000; mV+=77) {
+        unsigned int data = device.voltageToData(mV);
+        CHECK((unsigned long)data * 5000 / 4096 <= mV + 1);                   // highest code reading as mV or less
+        if (data < 4095) CHECK(lround((double)(data + 1) * 5000 / 4096) > mV);
+    }
+    CHECK_EQUAL(4095, device.voltageToData(6000));
+}
+
+static void testOversampledVoltage() {
+    MCP3221_SimI2C sim(TEST_DEV_ADDR);
+    MCP3221 device(TEST_DEV_ADDR);
+    device.setBus(sim);
+    sim.setWaveform(SIM_SQUARE, 1000, 1, 2);            // alternates 1000 / 1001
+    CHECK_NEAR(1000500, device.getOversampledVoltage(2), 1);                   // in uV
+    device.setVinput(VOLTAGE_INPUT_12V);
+    CHECK_NEAR(lround(1000.5 * (DEFAULT_RES_1 + DEFAULT_RES_2) / DEFAULT_RES_2 * 1000),
+               device.getOversampledVoltage(4), 100);
+}
+
+int main() {
+    RUN_TEST(test5V);
+    RUN_TEST(test12V);
+    RUN_TEST(testSettingsUpdateScale);
+    RUN_TEST(testLUT);
+    RUN_TEST(testVoltageToData);
+    RUN_TEST(testOversampledVoltage);
+    return testResult();
+}
@@ -0,0 +1,70 @@
+/*==============================================================================================================*
+
+    @file     MCP3221LogDecode.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+
+/*==============================================================================================================*
+    MCP3221 BINARY LOG DECODER (HOST TOOL)
+ *==============================================================================================================*
+
+    Converts a binary log written by MCP3221LogEncoder (see '/utility/MCP3221Log.h') into CSV lines of:
+    address,block timestamp,index within block,sample
+
+    Build:  g++ -O2 -o MCP3221LogDecode MCP3221LogDecode.cpp
+    Usage:  ./MCP3221LogDecode [log file]  (reads stdin when no file is given, e.g. a captured serial port)
+
+ *==============================================================================================================*/
+
+#include <stdio.h>
+#include "../../utility/MCP3221Log.h"
+
+int main(int argc, char *argv[]) {
+    FILE *in = (argc > 1) ? fopen(argv[1], "rb") : stdin;
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+    MCP3221LogDecoder decoder;
+    unsigned long numSamples = 0;
+    int data;
+    printf("address,timestamp,index,sample\n");
+    while ((data = fgetc(in)) != EOF) {
+        if (!decoder.feed(data)) continue;
+        printf("%u,%lu,%u,%u\n", decoder.getAddress(), (unsigned long)decoder.getTimestamp(),
+               decoder.getIndex(), decoder.getSample());
+        numSamples++;
+    }
+    fprintf(stderr, "%lu samples, %lu sync errors\n", numSamples, (unsigned long)decoder.getSyncErrors());
+    if (in != stdin) fclose(in);
+    return 0;
+}
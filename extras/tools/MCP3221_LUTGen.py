@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+"""
+MCP3221_LUTGen.py - Generates a PROGMEM voltage look-up table for MCP3221::setVoltageLUT()
+
+Usage:
+    python3 MCP3221_LUTGen.py [--vref 4096] [--vinput 5|12] [--res1 10000] [--res2 4700]
+                              [--size 256|4096] [--name MCP3221_LUT] > MCP3221_LUT.h
+
+A 4096-entry table holds the voltage (in mV) of every code; a 256-entry table holds every 16th code and
+is linearly interpolated by the library. The table must match the device's settings (Vref, voltage input &
+divider resistors), so it is meant for fixed configurations.
+
+MIT License (c) 2016 Nadav Matalon
+"""
+
+import argparse
+
+
+def voltage(code, args):
+    if args.vinput == 5:
+        return code * args.vref / 4096.0
+    return code * (args.res1 + args.res2) / float(args.res2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='MCP3221 voltage look-up table generator')
+    parser.add_argument('--vref', type=int, default=4096, help='voltage reference in mV (5V input only)')
+    parser.add_argument('--vinput', type=int, choices=(5, 12), default=5, help='voltage input (5 or 12)')
+    parser.add_argument('--res1', type=int, default=10000, help='voltage divider resistor 1 in ohms (12V input)')
+    parser.add_argument('--res2', type=int, default=4700, help='voltage divider resistor 2 in ohms (12V input)')
+    parser.add_argument('--size', type=int, choices=(256, 4096), default=256, help='number of table entries')
+    parser.add_argument('--name', default='MCP3221_LUT', help='name of the generated array')
+    args = parser.parse_args()
+
+    step = 4096 // args.size
+    values = [min(int(round(voltage(i * step, args))), 65535) for i in range(args.size)]
+
+    print('// Generated by MCP3221_LUTGen.py: --vref %d --vinput %d --res1 %d --res2 %d --size %d'
+          % (args.vref, args.vinput, args.res1, args.res2, args.size))
+    print('// Usage: mcp3221.setVoltageLUT(%s, %d);' % (args.name, args.size))
+    print('')
+    print('const uint16_t %s[%d] PROGMEM = {' % (args.name, args.size))
+    for row in range(0, args.size, 16):
+        line = ', '.join('%5d' % v for v in values[row:row + 16])
+        print('    %s%s' % (line, ',' if row + 16 < args.size else ''))
+    print('};')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,196 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Alarm.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221Alarm.h"
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221Alarm::MCP3221Alarm(MCP3221 &device) :
+    _device(device),
+    _high(ALARM_HIGH_OFF),
+    _low(ALARM_LOW_OFF),
+    _hysteresis(0),
+    _debounce(1),
+    _events(0),
+    _callback(NULL)
+    {
+        updateLimits();
+        reset();
+    }
+
+/*==============================================================================================================*
+    SET THRESHOLDS (IN COUNTS)
+ *==============================================================================================================*/
+
+void MCP3221Alarm::setHigh(unsigned int data) {
+    _high = data;
+    updateLimits();
+}
+
+void MCP3221Alarm::setLow(unsigned int data) {
+    _low = data;
+    updateLimits();
+}
+
+/*==============================================================================================================*
+    SET THRESHOLDS (IN mV, CONVERTED TO COUNTS ONCE)
+ *==============================================================================================================*/
+
+void MCP3221Alarm::setHighVoltage(unsigned int mV) {
+    setHigh(_device.voltageToData(mV));                                         // above: reads more than mV
+}
+
+void MCP3221Alarm::setLowVoltage(unsigned int mV) {
+    setLow(mV ? (_device.voltageToData(mV - 1) + 1) : ALARM_LOW_OFF);           // below: reads less than mV
+}
+
+/*==============================================================================================================*
+    SET HYSTERESIS (IN COUNTS) & DEBOUNCE (CONSECUTIVE READINGS)
+ *==============================================================================================================*/
+
+void MCP3221Alarm::setHysteresis(unsigned int counts) {
+    _hysteresis = counts;
+    updateLimits();
+}
+
+void MCP3221Alarm::setDebounce(byte readings) {
+    _debounce = max(readings, 1);
+}
+
+/*==============================================================================================================*
+    SET CALLBACK (NULL = FLAGS ONLY)
+ *==============================================================================================================*/
+
+void MCP3221Alarm::setCallback(mcp3221_alarm_callback_t callback) {
+    _callback = callback;
+}
+
+/*==============================================================================================================*
+    GETTERS
+ *==============================================================================================================*/
+
+unsigned int MCP3221Alarm::getHigh() {
+    return _high;
+}
+
+unsigned int MCP3221Alarm::getLow() {
+    return _low;
+}
+
+bool MCP3221Alarm::isHigh() {
+    return _isHigh;
+}
+
+bool MCP3221Alarm::isLow() {
+    return _isLow;
+}
+
+byte MCP3221Alarm::getEvents() {
+    byte events = _events;
+    _events = 0;
+    return events;
+}
+
+/*==============================================================================================================*
+    PROCESS (PASS-THROUGH)
+ *==============================================================================================================*/
+
+bool MCP3221Alarm::process(unsigned int &sample) {
+    check(sample);
+    return true;
+}
+
+size_t MCP3221Alarm::processBlock(uint16_t *samples, size_t count) {
+    for (size_t i=0; i<count; i++) check(samples[i]);
+    return count;
+}
+
+/*==============================================================================================================*
+    RESET (CLEARS THE ALARM STATES & LATCHED EVENTS, KEEPS THE SETTINGS)
+ *==============================================================================================================*/
+
+void MCP3221Alarm::reset() {
+    _isHigh = _isLow = false;
+    _highCount = _lowCount = 0;
+    _events = 0;
+}
+
+/*==============================================================================================================*
+    UPDATE LIMITS (PRECOMPUTES THE CLEAR LEVELS)
+ *==============================================================================================================*/
+
+void MCP3221Alarm::updateLimits() {
+    _highClear = (_high > _hysteresis) ? (_high - _hysteresis) : 0;
+    _lowClear = ((0xFFFF - _low) > _hysteresis) ? (_low + _hysteresis) : 0xFFFF;
+}
+
+/*==============================================================================================================*
+    CHECK (ONE READING AGAINST BOTH THRESHOLDS)
+ *==============================================================================================================*/
+
+void MCP3221Alarm::check(unsigned int sample) {
+    if (_isHigh ? (sample <= _highClear) : (sample > _high)) {
+        if (++_highCount >= _debounce) {
+            _isHigh = !_isHigh;
+            _highCount = 0;
+            raise(_isHigh ? ALARM_HIGH_SET : ALARM_HIGH_CLEAR, sample);
+        }
+    } else {
+        _highCount = 0;
+    }
+    if (_isLow ? (sample >= _lowClear) : (sample < _low)) {
+        if (++_lowCount >= _debounce) {
+            _isLow = !_isLow;
+            _lowCount = 0;
+            raise(_isLow ? ALARM_LOW_SET : ALARM_LOW_CLEAR, sample);
+        }
+    } else {
+        _lowCount = 0;
+    }
+}
+
+/*==============================================================================================================*
+    RAISE (LATCHES THE EVENT & CALLS THE CALLBACK)
+ *==============================================================================================================*/
+
+void MCP3221Alarm::raise(alarm_event_t event, unsigned int sample) {
+    _events |= event;
+    if (_callback) _callback(event, sample);
+}
@@ -0,0 +1,104 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Alarm.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Alarm_h
+#define MCP3221Alarm_h
+
+#include "MCP3221.h"
+#include "MCP3221Filters.h"
+
+namespace Mcp3221 {
+
+    const unsigned int ALARM_HIGH_OFF    = 0xFFFF;      // high threshold disabled (no 12-bit reading is above it)
+    const unsigned int ALARM_LOW_OFF     =      0;      // low threshold disabled (no reading is below it)
+
+    typedef enum:byte {                                 // event bits (passed to the callback & latched by getEvents())
+        ALARM_HIGH_SET   = 1,
+        ALARM_HIGH_CLEAR = 2,
+        ALARM_LOW_SET    = 4,
+        ALARM_LOW_CLEAR  = 8
+    } alarm_event_t;
+
+    typedef void (*mcp3221_alarm_callback_t)(alarm_event_t event, unsigned int data);
+
+/*==============================================================================================================*
+    ALARM STAGE (HIGH / LOW THRESHOLDS WITH HYSTERESIS & DEBOUNCE, CHECKED ON EVERY READING)
+ *==============================================================================================================*/
+
+// A pass-through pipeline stage: attach it with addStage() - first, so it sees raw readings rather than smoothed
+// ones - and each reading the device takes is compared against the thresholds as it is acquired, instead of
+// whenever the main loop gets around to it. Thresholds given in mV are converted to counts once (through the
+// device's calibration & voltage settings at the time of the call), so the per-sample check is two integer
+// compares. An alarm sets after 'debounce' consecutive readings beyond its threshold and clears after as many
+// readings back inside it by at least the hysteresis. Each transition calls the callback (if set) from within the
+// read and latches its event bit for getEvents().
+
+    class MCP3221Alarm : public MCP3221Stage {
+        public:
+            MCP3221Alarm(MCP3221 &device);
+            void          setHigh(unsigned int data);       // alarm above 'data' (ALARM_HIGH_OFF = disabled)
+            void          setLow(unsigned int data);        // alarm below 'data' (ALARM_LOW_OFF = disabled)
+            void          setHighVoltage(unsigned int mV);
+            void          setLowVoltage(unsigned int mV);
+            void          setHysteresis(unsigned int counts);
+            void          setDebounce(byte readings);       // consecutive readings needed to set / clear (1-255)
+            void          setCallback(mcp3221_alarm_callback_t callback);
+            unsigned int  getHigh();
+            unsigned int  getLow();
+            bool          isHigh();
+            bool          isLow();
+            byte          getEvents();                      // alarm_event_t bits since the last call (then cleared)
+            bool          process(unsigned int &sample);
+            size_t        processBlock(uint16_t *samples, size_t count);
+            void          reset();
+        private:
+            MCP3221       &_device;
+            unsigned int   _high, _low, _hysteresis, _highClear, _lowClear;
+            byte           _debounce, _highCount, _lowCount;
+            byte           _events;
+            bool           _isHigh, _isLow;
+            mcp3221_alarm_callback_t _callback;
+            void           updateLimits();
+            void           check(unsigned int sample);
+            void           raise(alarm_event_t event, unsigned int sample);
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
@@ -0,0 +1,133 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Blocks.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221Blocks.h"
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221BlocksBase::MCP3221BlocksBase(MCP3221 &device, block_source_t source, uint16_t *buffers, unsigned int blockSize) :
+    _device(device),
+    _buffers(buffers),
+    _blockSize(blockSize),
+    _source(source)
+    {
+        reset();
+    }
+
+/*==============================================================================================================*
+    UPDATE (READS UP TO 'maxSamples' INTO THE FILLING BUFFER, TRUE WHEN A BLOCK BECAME READY)
+ *==============================================================================================================*/
+
+bool MCP3221BlocksBase::update(unsigned int maxSamples) {
+    unsigned int room = _blockSize - _count;
+    if (maxSamples < room) room = maxSamples;
+    uint16_t *dst = _buffers + _fill * _blockSize + _count;
+    _count += (_source == BLOCK_QUEUE) ? _device.read(dst, room) : _device.readBurst(dst, room);
+    return (_count >= _blockSize) ? completeBlock() : false;
+}
+
+/*==============================================================================================================*
+    PUSH (ADDS A SINGLE READING, TRUE WHEN A BLOCK BECAME READY)
+ *==============================================================================================================*/
+
+bool MCP3221BlocksBase::push(unsigned int sample) {
+    _buffers[_fill * _blockSize + _count] = sample;
+    return (++_count >= _blockSize) ? completeBlock() : false;
+}
+
+/*==============================================================================================================*
+    GETTERS
+ *==============================================================================================================*/
+
+bool MCP3221BlocksBase::blockReady() {
+    return _ready;
+}
+
+uint16_t* MCP3221BlocksBase::getBlock() {
+    return _ready ? (_buffers + (_fill ^ 1) * _blockSize) : NULL;
+}
+
+unsigned int MCP3221BlocksBase::getBlockSize() {
+    return _blockSize;
+}
+
+unsigned long MCP3221BlocksBase::getBlocks() {
+    return _blocks;
+}
+
+unsigned long MCP3221BlocksBase::getOverruns() {
+    return _overruns;
+}
+
+/*==============================================================================================================*
+    RELEASE (THE READY BLOCK MAY NOW BE REFILLED)
+ *==============================================================================================================*/
+
+void MCP3221BlocksBase::release() {
+    _ready = false;
+}
+
+/*==============================================================================================================*
+    RESET (DISCARDS THE PARTIAL & READY BLOCKS, CLEARS THE COUNTERS)
+ *==============================================================================================================*/
+
+void MCP3221BlocksBase::reset() {
+    _fill = 0;
+    _count = 0;
+    _ready = false;
+    _blocks = 0;
+    _overruns = 0;
+}
+
+/*==============================================================================================================*
+    COMPLETE BLOCK (SWAPS BUFFERS, OR DROPS THE NEW BLOCK IF THE READY ONE IS STILL HELD)
+ *==============================================================================================================*/
+
+bool MCP3221BlocksBase::completeBlock() {
+    _count = 0;
+    _blocks++;
+    if (_ready) {
+        _overruns++;
+        return false;
+    }
+    _fill ^= 1;
+    _ready = true;
+    return true;
+}
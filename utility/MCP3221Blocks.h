@@ -0,0 +1,97 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Blocks.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Blocks_h
+#define MCP3221Blocks_h
+
+#include "MCP3221.h"
+
+namespace Mcp3221 {
+
+    typedef enum:byte {
+        BLOCK_BURST = 0,                                // update() takes burst reads (readBurst())
+        BLOCK_QUEUE = 1                                 // update() drains asynchronous acquisition (read())
+    } block_source_t;
+
+/*==============================================================================================================*
+    PING-PONG BLOCK ACQUISITION (TWO FIXED-SIZE BUFFERS: ONE FILLING, ONE HELD BY THE SKETCH)
+ *==============================================================================================================*/
+
+// update() reads straight into the free buffer - through readBurst(), or read() when the device runs
+// asynchronous acquisition - so the device's filter stages run over each chunk as a block and no sample is
+// copied. push() adds single readings instead (e.g. from an MCP3221Sampler). Once a buffer is full it becomes
+// the ready block and filling moves on to the other one; the sketch processes the ready block in place and
+// hands it back with release(). If the filling buffer completes while the ready block is still held, the new
+// block is dropped (counted as an overrun) and refilled, so the block being processed is never overwritten.
+
+    class MCP3221BlocksBase {
+        public:
+            bool          update(unsigned int maxSamples = 0xFFFF);  // true when a block became ready
+            bool          push(unsigned int sample);                 // true when a block became ready
+            bool          blockReady();
+            uint16_t*     getBlock();                   // ready block (NULL if none)
+            unsigned int  getBlockSize();
+            void          release();                    // hands the ready block back for filling
+            unsigned long getBlocks();                  // blocks completed (including overruns)
+            unsigned long getOverruns();                // blocks dropped because the ready block was still held
+            void          reset();
+        protected:
+            MCP3221BlocksBase(MCP3221 &device, block_source_t source, uint16_t *buffers, unsigned int blockSize);
+        private:
+            MCP3221       &_device;
+            uint16_t      *_buffers;
+            unsigned int   _blockSize, _count;
+            unsigned long  _blocks, _overruns;
+            byte           _source, _fill;
+            bool           _ready;
+            bool           completeBlock();
+    };
+
+    template<unsigned int BLOCK_SIZE> class MCP3221Blocks : public MCP3221BlocksBase {
+        static_assert(BLOCK_SIZE > 0, "MCP3221Blocks: BLOCK_SIZE must be at least 1");
+        public:
+            MCP3221Blocks(MCP3221 &device, block_source_t source = BLOCK_BURST) :
+                MCP3221BlocksBase(device, source, _storage, BLOCK_SIZE) {}
+        private:
+            uint16_t _storage[2 * BLOCK_SIZE];
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
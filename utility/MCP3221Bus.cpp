@@ -0,0 +1,217 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Bus.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221Bus.h"
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221Bus::MCP3221Bus() :
+    _numDevices(0),
+    _next(0),
+    _updated(0),
+    _present(0),
+    _rescan(BUS_RESCAN),
+    _rounds(0)
+    {}
+
+/*==============================================================================================================*
+    ADD DEVICE (CHANNELS ARE NUMBERED IN ORDER OF ADDITION)
+ *==============================================================================================================*/
+
+bool MCP3221Bus::addDevice(MCP3221 &device) {
+    if (_numDevices >= BUS_MAX_DEVICES) return false;
+    _devices[_numDevices] = &device;
+    _fails[_numDevices] = 0;
+    _skip[_numDevices] = 0;
+    _values[_numDevices] = 0;
+    _numDevices++;
+    return true;
+}
+
+/*==============================================================================================================*
+    BEGIN (PINGS ALL DEVICES, RETURNS NUMBER OF DEVICES FOUND)
+ *==============================================================================================================*/
+
+byte MCP3221Bus::begin() {
+    byte numFound = 0;
+    _next = _updated = _present = 0;
+    _rounds = 0;
+    for (byte channel=0; channel<_numDevices; channel++) {
+        _fails[channel] = _skip[channel] = 0;
+        if (_devices[channel]->ping() == COM_SUCCESS) {
+            _present |= (1 << channel);
+            numFound++;
+        }
+    }
+    return numFound;
+}
+
+/*==============================================================================================================*
+    SET RESCAN INTERVAL (IN ROUNDS, 0 = ABSENT DEVICES ARE NEVER PINGED AGAIN)
+ *==============================================================================================================*/
+
+void MCP3221Bus::setRescan(unsigned int rounds) {
+    _rescan = rounds;
+}
+
+/*==============================================================================================================*
+    GET NUMBER OF DEVICES ADDED
+ *==============================================================================================================*/
+
+byte MCP3221Bus::getNumDevices() {
+    return _numDevices;
+}
+
+/*==============================================================================================================*
+    GET I2C ADDRESS OF CHANNEL
+ *==============================================================================================================*/
+
+byte MCP3221Bus::getAddress(byte channel) {
+    return (channel < _numDevices) ? _devices[channel]->_devAddr : 0;
+}
+
+/*==============================================================================================================*
+    IS PRESENT (TRUE ONCE THE CHANNEL ANSWERED begin() OR A RESCAN)
+ *==============================================================================================================*/
+
+bool MCP3221Bus::isPresent(byte channel) {
+    return (channel < _numDevices) && (_present & (1 << channel));
+}
+
+/*==============================================================================================================*
+    IS ONLINE (FALSE WHILE THE CHANNEL IS ABSENT OR ITS LATEST READ HAS FAILED)
+ *==============================================================================================================*/
+
+bool MCP3221Bus::isOnline(byte channel) {
+    return isPresent(channel) && !_fails[channel];
+}
+
+/*==============================================================================================================*
+    UPDATE (READS THE NEXT DUE DEVICE IN ROUND-ROBIN ORDER)
+ *==============================================================================================================*/
+
+bool MCP3221Bus::update() {
+    for (byte i=0; i<_numDevices; i++) {
+        byte channel = _next;
+        bool lastInRound = (++_next >= _numDevices);
+        bool read = false, stored = false;
+        if (lastInRound) _next = 0;
+        if (isPresent(channel)) {
+            if (_skip[channel]) _skip[channel]--;                          // backing off a failing device
+            else {
+                read = true;
+                stored = readChannel(channel);
+            }
+        }
+        if (lastInRound) endRound();                                       // the round's last channel done
+        if (read) return stored;
+    }
+    return false;
+}
+
+/*==============================================================================================================*
+    UPDATE ALL (ONE FULL ROUND, RETURNS NUMBER OF VALUES STORED)
+ *==============================================================================================================*/
+
+byte MCP3221Bus::updateAll() {
+    byte numStored = 0;
+    for (byte channel=0; channel<_numDevices; channel++) {
+        if (!isPresent(channel)) continue;
+        if (_skip[channel]) _skip[channel]--;
+        else if (readChannel(channel)) numStored++;
+    }
+    endRound();
+    return numStored;
+}
+
+/*==============================================================================================================*
+    GET LATEST VALUE OF CHANNEL
+ *==============================================================================================================*/
+
+unsigned int MCP3221Bus::getValue(byte channel) {
+    return (channel < _numDevices) ? _values[channel] : 0;
+}
+
+/*==============================================================================================================*
+    GET LATEST VALUES (PACKED ARRAY, ONE ENTRY PER CHANNEL)
+ *==============================================================================================================*/
+
+const uint16_t *MCP3221Bus::getValues() {
+    return _values;
+}
+
+/*==============================================================================================================*
+    GET UPDATED CHANNELS (BITMASK, CLEARED ON READ)
+ *==============================================================================================================*/
+
+byte MCP3221Bus::getUpdated() {
+    byte updated = _updated;
+    _updated = 0;
+    return updated;
+}
+
+/*==============================================================================================================*
+    READ CHANNEL (THROUGH THE DEVICE'S OWN FILTERS, ONE TRANSACTION: THE BACKOFF REPLACES RETRIES & PINGS)
+ *==============================================================================================================*/
+
+bool MCP3221Bus::readChannel(byte channel) {
+    unsigned int value;
+    if (_devices[channel]->readDataOnce(value) == SAMPLE_VALID) {
+        _values[channel] = value;
+        _fails[channel] = 0;
+        _updated |= (1 << channel);
+        return true;
+    }
+    _skip[channel] = 1 << _fails[channel];                                 // 1, 2, 4 ... 64 rounds
+    if (_fails[channel] < BUS_MAX_BACKOFF) _fails[channel]++;
+    return false;
+}
+
+/*==============================================================================================================*
+    END ROUND (PINGS ABSENT DEVICES EVERY 'RESCAN' ROUNDS)
+ *==============================================================================================================*/
+
+void MCP3221Bus::endRound() {
+    if (!_rescan || (++_rounds < _rescan)) return;
+    _rounds = 0;
+    for (byte channel=0; channel<_numDevices; channel++) {
+        if (!isPresent(channel) && (_devices[channel]->ping() == COM_SUCCESS)) _present |= (1 << channel);
+    }
+}
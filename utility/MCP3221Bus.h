@@ -0,0 +1,91 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Bus.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Bus_h
+#define MCP3221Bus_h
+
+#include "MCP3221.h"
+
+namespace Mcp3221 {
+
+    const byte         BUS_MAX_DEVICES =    8;      // MCP3221A0 - MCP3221A7 (0x48 - 0x4F)
+    const byte         BUS_MAX_BACKOFF =    6;      // a failing device is skipped for up to 2^6 = 64 rounds
+    const unsigned int BUS_RESCAN      =   16;      // default rounds between pings of absent devices
+
+/*==============================================================================================================*
+    MCP3221 BUS GROUP (ROUND-ROBIN READING OF ALL MCP3221'S SHARING ONE I2C BUS)
+ *==============================================================================================================*/
+
+// Devices are added as MCP3221 instances, so each is read through its own readDataOnce() - with its filter
+// stages, smoothing and calibration - and gives the same values whether read directly or through the group.
+// begin() pings them all; update() then reads the next due device and stores its value in a packed array
+// (channel = order of addition). Each read is a single transaction: a failed read is neither retried nor
+// followed by a ping; instead the device is skipped for an exponentially growing number of rounds (1, 2, 4 ...
+// 64) and retried by the next regular read. Devices that didn't answer begin() are absent: they are pinged
+// again every 'rescan' rounds and read once they answer.
+
+    class MCP3221Bus {
+        public:
+            MCP3221Bus();
+            bool            addDevice(MCP3221 &device);         // false if the group is full
+            byte            begin();                            // pings all devices, returns number found
+            void            setRescan(unsigned int rounds);     // rounds between pings of absent devices (0 = never)
+            byte            getNumDevices();
+            byte            getAddress(byte channel);
+            bool            isPresent(byte channel);            // answered begin() or a rescan
+            bool            isOnline(byte channel);             // present and its latest read succeeded
+            bool            update();                           // reads next due device, true if a value was stored
+            byte            updateAll();                        // one full round, returns number of values stored
+            unsigned int    getValue(byte channel);
+            const uint16_t *getValues();                        // packed array of latest values (one per channel)
+            byte            getUpdated();                       // bitmask of channels updated since last call
+        private:
+            MCP3221     *_devices[BUS_MAX_DEVICES];
+            byte         _numDevices, _next, _updated, _present;
+            byte         _fails[BUS_MAX_DEVICES];
+            byte         _skip[BUS_MAX_DEVICES];
+            uint16_t     _values[BUS_MAX_DEVICES];
+            unsigned int _rescan, _rounds;
+            bool         readChannel(byte channel);
+            void         endRound();
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
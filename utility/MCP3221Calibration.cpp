@@ -0,0 +1,196 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Calibration.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include <EEPROM.h>
+#include "MCP3221Calibration.h"
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221Calibration::MCP3221Calibration(MCP3221 &device) :
+    _device(device)
+    {
+        _record.numPoints = 0;
+    }
+
+/*==============================================================================================================*
+    ADD POINT (TAKES THE READING FROM THE DEVICE, RETURNS FALSE IF THE READ FAILED OR THE TABLE IS FULL)
+ *==============================================================================================================*/
+
+bool MCP3221Calibration::addPoint(unsigned int mV) {
+    unsigned int raw;
+    if (_device.readOversampled(CAL_EXTRA_BITS, raw) != SAMPLE_VALID) return false;   // bypasses smoothing & stages
+    return insertPoint(raw, mV);
+}
+
+/*==============================================================================================================*
+    ADD POINT (12-BIT READING, e.g. AVERAGED BY THE SKETCH)
+ *==============================================================================================================*/
+
+bool MCP3221Calibration::addPoint(unsigned int rawData, unsigned int mV) {
+    return insertPoint(min(rawData, 4095) << CAL_EXTRA_BITS, mV);
+}
+
+/*==============================================================================================================*
+    GET NUMBER OF POINTS
+ *==============================================================================================================*/
+
+byte MCP3221Calibration::getNumPoints() {
+    return _record.numPoints;
+}
+
+/*==============================================================================================================*
+    APPLY (EVALUATES THE POINTS AT THE TABLE KNOTS, RETURNS FALSE WITHOUT POINTS)
+ *==============================================================================================================*/
+
+// Reference voltages are turned into the code the nominal settings map to that voltage, so the table corrects
+// codes and getVoltage() keeps its single scale step. Beyond the outer points the outer segment is extended
+// (or the offset, with a single point). 64-bit math, but only 17 times per apply().
+
+bool MCP3221Calibration::apply() {
+    byte n = _record.numPoints;
+    if (!n || !_device._vScale) return false;
+    int64_t ideal[MAX_CAL_POINTS];                                              // target codes (in 1/4 codes)
+    byte shift = _device._vShift + CAL_EXTRA_BITS;
+    for (byte i=0; i<n; i++) ideal[i] = (((uint64_t)_record.mV[i] << shift) + (_device._vScale >> 1)) / _device._vScale;
+    for (byte k=0; k<CAL_KNOTS; k++) {
+        int64_t x = (int64_t)k << (CAL_KNOT_SHIFT + CAL_EXTRA_BITS);
+        int64_t y;
+        if (n == 1) {
+            y = x + ideal[0] - _record.raw[0];
+        } else {
+            byte seg = 0;
+            while ((seg < (n - 2)) && (x >= _record.raw[seg + 1])) seg++;
+            int64_t run = (int64_t)_record.raw[seg + 1] - _record.raw[seg];
+            int64_t rise = ideal[seg + 1] - ideal[seg];
+            int64_t offset = (x - _record.raw[seg]) * rise;
+            y = ideal[seg] + ((offset >= 0) ? (offset + run / 2) : (offset - run / 2)) / run;
+        }
+        y = (y + (1 << (CAL_EXTRA_BITS - 1))) >> CAL_EXTRA_BITS;
+        _table[k] = (y < 0) ? 0 : ((y > MAX_CAL_CODE) ? MAX_CAL_CODE : y);
+    }
+    _device.setCalibration(_table);
+    return true;
+}
+
+/*==============================================================================================================*
+    CLEAR (REMOVES ALL POINTS & RESTORES THE UNCORRECTED CONVERSION)
+ *==============================================================================================================*/
+
+void MCP3221Calibration::clear() {
+    _record.numPoints = 0;
+    _device.setCalibration(NULL);
+}
+
+/*==============================================================================================================*
+    SAVE (WRITES THE POINTS TO THE DEVICE'S EEPROM SLOT, RETURNS FALSE WITHOUT POINTS)
+ *==============================================================================================================*/
+
+bool MCP3221Calibration::save() {
+    if (!_record.numPoints) return false;
+    _record.magic = CAL_MAGIC;
+    _record.devAddr = _device._devAddr;
+    for (byte i=_record.numPoints; i<MAX_CAL_POINTS; i++) _record.raw[i] = _record.mV[i] = 0;
+    _record.checksum = checksum();
+    EEPROM.put(eepromAddr(), _record);                                          // only changed bytes are written
+    return true;
+}
+
+/*==============================================================================================================*
+    LOAD (READS & VALIDATES THE DEVICE'S EEPROM SLOT, THEN APPLIES IT; FALSE IF THE SLOT IS EMPTY OR CORRUPT)
+ *==============================================================================================================*/
+
+bool MCP3221Calibration::load() {
+    EEPROM.get(eepromAddr(), _record);
+    if ((_record.magic != CAL_MAGIC) || (_record.devAddr != _device._devAddr) || (_record.checksum != checksum())
+        || !_record.numPoints || (_record.numPoints > MAX_CAL_POINTS)) {
+        _record.numPoints = 0;
+        return false;
+    }
+    return apply();
+}
+
+/*==============================================================================================================*
+    ERASE (INVALIDATES THE DEVICE'S EEPROM SLOT)
+ *==============================================================================================================*/
+
+void MCP3221Calibration::erase() {
+    EEPROM.put(eepromAddr(), (uint16_t)0xFFFF);
+}
+
+/*==============================================================================================================*
+    INSERT POINT (KEEPS THE POINTS SORTED BY READING, A REPEATED READING REPLACES ITS VOLTAGE)
+ *==============================================================================================================*/
+
+bool MCP3221Calibration::insertPoint(uint16_t raw, unsigned int mV) {
+    byte i = 0;
+    while ((i < _record.numPoints) && (_record.raw[i] < raw)) i++;
+    if ((i < _record.numPoints) && (_record.raw[i] == raw)) {
+        _record.mV[i] = mV;
+        return true;
+    }
+    if (_record.numPoints >= MAX_CAL_POINTS) return false;
+    for (byte j=_record.numPoints; j>i; j--) {
+        _record.raw[j] = _record.raw[j - 1];
+        _record.mV[j] = _record.mV[j - 1];
+    }
+    _record.raw[i] = raw;
+    _record.mV[i] = mV;
+    _record.numPoints++;
+    return true;
+}
+
+/*==============================================================================================================*
+    EEPROM ADDRESS (ONE SLOT PER I2C ADDRESS 0x48-0x4F)
+ *==============================================================================================================*/
+
+int MCP3221Calibration::eepromAddr() {
+    return MCP3221_CAL_EEPROM_ADDR + (_device._devAddr & 0x07) * sizeof(mcp3221_cal_record_t);
+}
+
+/*==============================================================================================================*
+    CHECKSUM (OVER ALL RECORD BYTES BEFORE THE CHECKSUM ITSELF)
+ *==============================================================================================================*/
+
+byte MCP3221Calibration::checksum() {
+    const byte *bytes = (const byte*)&_record;
+    byte sum = 0;
+    for (size_t i=0; i<offsetof(mcp3221_cal_record_t, checksum); i++) sum += bytes[i];
+    return -sum;
+}
@@ -0,0 +1,99 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Calibration.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Calibration_h
+#define MCP3221Calibration_h
+
+#include "MCP3221.h"
+
+#ifndef MCP3221_CAL_EEPROM_ADDR
+#define MCP3221_CAL_EEPROM_ADDR 0                       // EEPROM address of the first calibration slot
+#endif
+
+namespace Mcp3221 {
+
+    const byte         MAX_CAL_POINTS      =      5;    // reference points per device (4 bytes of RAM & EEPROM each)
+    const byte         CAL_EXTRA_BITS      =      2;    // reference readings average 16 samples (in 1/4 codes)
+    const unsigned int CAL_MAGIC           = 0xCA1B;    // marks a written calibration slot
+
+    typedef struct {
+        uint16_t magic;                                 // CAL_MAGIC
+        byte     devAddr;                               // I2C address the slot was written for
+        byte     numPoints;
+        uint16_t raw[MAX_CAL_POINTS];                   // reading in 1/4 codes, ascending
+        uint16_t mV[MAX_CAL_POINTS];                    // reference voltage (in mV)
+        byte     checksum;                              // two's complement of the sum of the bytes above
+    } mcp3221_cal_record_t;
+
+/*==============================================================================================================*
+    CALIBRATION (REFERENCE POINTS -> PRECOMPUTED CORRECTION TABLE, PERSISTED IN EEPROM)
+ *==============================================================================================================*/
+
+// Each reference point pairs a reading with the voltage actually present at the input (measured with a good
+// meter). One point corrects offset only, two correct offset & gain, and further points add piecewise-linear
+// segments for non-linearity. apply() evaluates the resulting line at the 17 knots of a correction table held by
+// this object and hands it to the device, so the per-sample correction stays a table look-up whatever the number
+// of points (and only calibrated devices carry a table). Keep the object alive while the device uses its table.
+// Points are converted through the device's current voltage settings, so set vRef / the divider resistors
+// before apply() or load().
+// Each address 0x48-0x4F has its own EEPROM slot (sizeof(mcp3221_cal_record_t) bytes from MCP3221_CAL_EEPROM_ADDR).
+
+    class MCP3221Calibration {
+        public:
+            MCP3221Calibration(MCP3221 &device);
+            bool          addPoint(unsigned int mV);                    // reads the device (16-sample average)
+            bool          addPoint(unsigned int rawData, unsigned int mV);
+            byte          getNumPoints();
+            bool          apply();                                      // builds & sets the device's table
+            void          clear();                                      // drops the points & the device's correction
+            bool          save();
+            bool          load();                                       // reads the slot & applies it
+            void          erase();
+        private:
+            MCP3221       &_device;
+            mcp3221_cal_record_t _record;
+            uint16_t      _table[CAL_KNOTS];                            // the device's correction table
+            bool          insertPoint(uint16_t raw, unsigned int mV);
+            int           eepromAddr();
+            byte          checksum();
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
@@ -0,0 +1,181 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Capture.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221Capture.h"
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221CaptureBase::MCP3221CaptureBase(uint16_t *buffer, unsigned int size) :
+    _buffer(buffer),
+    _size(size),
+    _preTrigger(size >> 1),
+    _nextPreTrigger(size >> 1),
+    _level(2048),
+    _mode(TRIGGER_RISING)
+    {
+        reset();
+    }
+
+/*==============================================================================================================*
+    SETTINGS (THE TRIGGER APPLIES AT ONCE, THE PRE-TRIGGER LENGTH IS STAGED UNTIL THE NEXT arm())
+ *==============================================================================================================*/
+
+void MCP3221CaptureBase::setTrigger(unsigned int level, trigger_mode_t mode) {
+    _level = level;
+    _mode = mode;
+}
+
+void MCP3221CaptureBase::setPreTrigger(unsigned int samples) {
+    _nextPreTrigger = min(samples, _size - 1);                                   // a running record keeps its own
+}
+
+/*==============================================================================================================*
+    ARM / TRIGGER / STOP
+ *==============================================================================================================*/
+
+void MCP3221CaptureBase::arm() {
+    _preTrigger = _nextPreTrigger;
+    _index = 0;
+    _recorded = 0;
+    _forced = false;
+    _state = CAPTURE_ARMED;
+}
+
+void MCP3221CaptureBase::trigger() {
+    if (_state == CAPTURE_ARMED) _forced = true;                                // fires once the pre-trigger is full
+}
+
+void MCP3221CaptureBase::stop() {
+    _recorded = 0;
+    _state = CAPTURE_IDLE;
+}
+
+/*==============================================================================================================*
+    GETTERS
+ *==============================================================================================================*/
+
+capture_state_t MCP3221CaptureBase::getState() {
+    return (capture_state_t)_state;
+}
+
+bool MCP3221CaptureBase::isDone() {
+    return (_state == CAPTURE_DONE);
+}
+
+unsigned int MCP3221CaptureBase::getLength() {
+    return min(_recorded, _size);
+}
+
+unsigned int MCP3221CaptureBase::getTriggerIndex() {
+    return _preTrigger;
+}
+
+unsigned int MCP3221CaptureBase::getSample(unsigned int index) {
+    if (index >= getLength()) return 0;
+    unsigned int start = (_state >= CAPTURE_TRIGGERED) ? _start : ((_recorded > _size) ? _index : 0);
+    index += start;
+    return _buffer[(index < _size) ? index : (index - _size)];
+}
+
+unsigned long MCP3221CaptureBase::getTriggerTime() {
+    return _triggerTime;
+}
+
+/*==============================================================================================================*
+    PROCESS (PASS-THROUGH)
+ *==============================================================================================================*/
+
+bool MCP3221CaptureBase::process(unsigned int &sample) {
+    if ((_state == CAPTURE_ARMED) || (_state == CAPTURE_TRIGGERED)) add(sample);
+    return true;
+}
+
+size_t MCP3221CaptureBase::processBlock(uint16_t *samples, size_t count) {
+    for (size_t i=0; (i < count) && ((_state == CAPTURE_ARMED) || (_state == CAPTURE_TRIGGERED)); i++) add(samples[i]);
+    return count;
+}
+
+/*==============================================================================================================*
+    RESET (DISARMS, KEEPS THE SETTINGS)
+ *==============================================================================================================*/
+
+void MCP3221CaptureBase::reset() {
+    stop();
+    _index = 0;
+    _triggerTime = 0;
+    _forced = false;
+}
+
+/*==============================================================================================================*
+    ADD (RECORDS A READING & CHECKS THE TRIGGER / POST-TRIGGER COUNT)
+ *==============================================================================================================*/
+
+void MCP3221CaptureBase::add(unsigned int sample) {
+    _buffer[_index] = sample;
+    if (++_index >= _size) _index = 0;
+    if (_recorded <= _size) _recorded++;                                        // saturates just past a full buffer
+    if (_state == CAPTURE_TRIGGERED) {
+        if (!--_remaining) _state = CAPTURE_DONE;
+    } else if (_recorded > _preTrigger) {
+        bool fired = _forced;
+        if (!fired) switch (_mode) {
+            case (TRIGGER_RISING):  fired = (_recorded > 1) && (_previous < _level) && (sample >= _level); break;
+            case (TRIGGER_FALLING): fired = (_recorded > 1) && (_previous > _level) && (sample <= _level); break;
+            case (TRIGGER_ABOVE):   fired = (sample > _level); break;
+            default:                fired = (sample < _level); break;
+        }
+        if (fired) fire();
+    }
+    _previous = sample;
+}
+
+/*==============================================================================================================*
+    FIRE (THE LATEST READING BECOMES THE TRIGGER READING)
+ *==============================================================================================================*/
+
+void MCP3221CaptureBase::fire() {
+    _triggerTime = micros();
+    _forced = false;
+    unsigned int triggerPos = _index ? (_index - 1) : (_size - 1);
+    _start = (triggerPos >= _preTrigger) ? (triggerPos - _preTrigger) : (triggerPos + _size - _preTrigger);
+    _remaining = _size - _preTrigger - 1;
+    _recorded = _preTrigger + 1;                                                // older readings drop out of the record
+    _state = _remaining ? CAPTURE_TRIGGERED : CAPTURE_DONE;
+}
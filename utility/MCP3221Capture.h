@@ -0,0 +1,111 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Capture.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Capture_h
+#define MCP3221Capture_h
+
+#include "MCP3221.h"
+#include "MCP3221Filters.h"
+
+namespace Mcp3221 {
+
+    typedef enum:byte {
+        TRIGGER_RISING  = 0,                            // reading crosses the level upwards
+        TRIGGER_FALLING = 1,                            // reading crosses the level downwards
+        TRIGGER_ABOVE   = 2,                            // reading above the level
+        TRIGGER_BELOW   = 3                             // reading below the level
+    } trigger_mode_t;
+
+    typedef enum:byte {
+        CAPTURE_IDLE      = 0,                          // not armed
+        CAPTURE_ARMED     = 1,                          // recording pre-trigger readings, waiting for the trigger
+        CAPTURE_TRIGGERED = 2,                          // recording post-trigger readings
+        CAPTURE_DONE      = 3                           // record complete & frozen
+    } capture_state_t;
+
+/*==============================================================================================================*
+    PRE-TRIGGER CAPTURE (TRANSIENT RECORDER: READINGS BEFORE & AFTER A TRIGGER)
+ *==============================================================================================================*/
+
+// A pass-through pipeline stage: attach it with addStage() (first, to record raw readings) and read the device
+// at full rate, e.g. with readBurst(). Once armed, every reading goes into a circular buffer; after at least
+// the pre-trigger count has been recorded, the trigger condition (integer compares against the previous and
+// current reading) is checked on each reading. When it fires, the remaining SIZE - preTrigger - 1 readings are
+// recorded and the record is frozen until the next arm(). getSample() reads the record in chronological order,
+// with the trigger reading at index getTriggerIndex().
+
+    class MCP3221CaptureBase : public MCP3221Stage {
+        public:
+            void            setTrigger(unsigned int level, trigger_mode_t mode = TRIGGER_RISING);   // level in counts
+            void            setPreTrigger(unsigned int samples);        // readings before the trigger (< SIZE, next arm())
+            void            arm();
+            void            trigger();                                  // forces the trigger (pre-trigger permitting)
+            void            stop();                                     // disarms, discarding the record
+            capture_state_t getState();
+            bool            isDone();
+            unsigned int    getLength();                                // readings in the record (SIZE once done)
+            unsigned int    getTriggerIndex();
+            unsigned int    getSample(unsigned int index);              // chronological (0 = oldest)
+            unsigned long   getTriggerTime();                           // micros() when the trigger fired
+            bool            process(unsigned int &sample);
+            size_t          processBlock(uint16_t *samples, size_t count);
+            void            reset();
+        protected:
+            MCP3221CaptureBase(uint16_t *buffer, unsigned int size);
+        private:
+            uint16_t       *_buffer;
+            unsigned int    _size, _preTrigger, _nextPreTrigger, _level, _index, _recorded, _remaining, _start, _previous;
+            unsigned long   _triggerTime;
+            byte            _mode, _state;
+            bool            _forced;
+            void            add(unsigned int sample);
+            void            fire();
+    };
+
+    template<unsigned int SIZE> class MCP3221Capture : public MCP3221CaptureBase {
+        static_assert(SIZE > 1, "MCP3221Capture: SIZE must be at least 2");
+        public:
+            MCP3221Capture() : MCP3221CaptureBase(_storage, SIZE) {}
+        private:
+            uint16_t _storage[SIZE];
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
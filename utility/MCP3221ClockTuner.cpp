@@ -0,0 +1,147 @@
+/*==============================================================================================================*
+
+    @file     utility/MCP3221ClockTuner.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+
+#include "MCP3221ClockTuner.h"
+
+const uint32_t TUNER_CLOCKS[TUNER_NUM_CLOCKS] PROGMEM = {       // candidate clock rates (in Hz, ascending)
+    50000, 100000, 150000, 200000, 250000, 300000, 400000, 500000, 600000, 800000
+};
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221ClockTuner::MCP3221ClockTuner(MCP3221 &device, uint32_t minClock, uint32_t maxClock) :
+    _device(device),
+    _clock(0),
+    _margin(TUNER_MARGIN),
+    _testReads(TUNER_TEST_READS),
+    _retunes(0),
+    _interval(TUNER_INTERVAL),
+    _lastCheck(0)
+    {
+        setRange(minClock, maxClock);
+    }
+
+/*==============================================================================================================*
+    SETTINGS
+ *==============================================================================================================*/
+
+void MCP3221ClockTuner::setRange(uint32_t minClock, uint32_t maxClock) {
+    _minClock = min(minClock, maxClock);
+    _maxClock = max(minClock, maxClock);
+}
+
+void MCP3221ClockTuner::setMargin(byte steps) {
+    _margin = steps;
+}
+
+void MCP3221ClockTuner::setTestReads(unsigned int reads) {
+    _testReads = max(reads, 1U);
+}
+
+void MCP3221ClockTuner::setInterval(unsigned long interval) {
+    _interval = interval;
+}
+
+/*==============================================================================================================*
+    TUNE (STEPS UP THROUGH THE CANDIDATE RATES & SETTLES BELOW THE FIRST ONE THAT FAILS)
+ *==============================================================================================================*/
+
+bool MCP3221ClockTuner::tune() {
+    int first = -1, passed = -1, failed = -1;
+    for (byte i=0; i<TUNER_NUM_CLOCKS; i++) {
+        uint32_t clock = pgm_read_dword(&TUNER_CLOCKS[i]);
+        if ((clock < _minClock) || (clock > _maxClock)) continue;
+        if (first < 0) first = i;
+        if (!_device.getBus().setClock(clock)) return false;             // bus has no clock control
+        if (!testClock()) {
+            failed = i;
+            break;
+        }
+        passed = i;
+    }
+    _lastCheck = millis();
+    if (first < 0) return false;                                          // no candidate within the range
+    int pick = (failed < 0) ? passed : max(passed - (int)_margin, first);          // 'margin' below the fastest pass
+    _clock = pgm_read_dword(&TUNER_CLOCKS[pick]);
+    _device.getBus().setClock(_clock);
+    return (passed >= 0);
+}
+
+/*==============================================================================================================*
+    UPDATE (PERIODIC RE-CHECK AT THE CURRENT RATE, CALL ON EVERY PASS OF loop())
+ *==============================================================================================================*/
+
+bool MCP3221ClockTuner::update() {
+    if (!_clock || !_interval || (millis() - _lastCheck < _interval)) return false;
+    _lastCheck = millis();
+    if (testClock()) return false;
+    uint32_t clock = _clock;
+    _retunes++;
+    tune();
+    return (_clock != clock);
+}
+
+/*==============================================================================================================*
+    GET CURRENT CLOCK RATE (IN Hz) & NUMBER OF RE-TUNES
+ *==============================================================================================================*/
+
+uint32_t MCP3221ClockTuner::getClock() {
+    return _clock;
+}
+
+unsigned int MCP3221ClockTuner::getRetunes() {
+    return _retunes;
+}
+
+/*==============================================================================================================*
+    TEST CLOCK (BURST OF SINGLE-SAMPLE READS, FALSE ON THE FIRST FAILURE)
+ *==============================================================================================================*/
+
+bool MCP3221ClockTuner::testClock() {
+    for (unsigned int i=0; i<_testReads; i++) {
+        uint16_t sample;
+        if (!_device.readSamples(&sample, 1) || (sample & 0xF000)) {       // short read or garbled leading zeros
+            if (_device._comBuffer >= COM_BUS_ERROR) _device.getBus().recover();
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,89 @@
+/*==============================================================================================================*
+
+    @file     utility/MCP3221ClockTuner.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+
+#ifndef MCP3221ClockTuner_h
+#define MCP3221ClockTuner_h
+
+#include "MCP3221.h"
+
+namespace Mcp3221 {
+
+    const uint32_t      TUNER_MIN_CLOCK     = 100000;   // default lowest I2C clock rate tried (in Hz)
+    const uint32_t      TUNER_MAX_CLOCK     = 400000;   // default highest I2C clock rate tried (in Hz)
+    const byte          TUNER_MARGIN        =      1;   // default steps kept below the fastest passing rate
+    const unsigned int  TUNER_TEST_READS    =     64;   // default read transactions per test burst
+    const unsigned long TUNER_INTERVAL      =  60000;   // default re-check interval (in mS)
+    const byte          TUNER_NUM_CLOCKS    =     10;   // number of candidate clock rates
+
+/*==============================================================================================================*
+    I2C CLOCK-RATE TUNER (FASTEST RELIABLE SCL RATE FOR THE INSTALLATION'S WIRING)
+ *==============================================================================================================*/
+
+// Steps the bus clock up through a fixed table of candidate rates within the given range, running a burst of
+// single-sample reads at each. A read fails if it comes back short (which the device reports through ping(), as
+// any failed read) or with any of the 4 leading zero bits set. The first rate with a failure marks the limit of
+// the wiring: the rate below it is the fastest that passed, and the tuner settles 'margin' further steps below
+// that (0 = the fastest passing rate itself); if every rate up to the maximum passes, the maximum is used as is.
+// Test reads bypass the retry policy and the filter stages, so they neither hide errors nor disturb the readings.
+// update() repeats the burst at the current rate every 'interval' mS and re-tunes if it fails.
+
+    class MCP3221ClockTuner {
+        public:
+            MCP3221ClockTuner(MCP3221 &device, uint32_t minClock=TUNER_MIN_CLOCK, uint32_t maxClock=TUNER_MAX_CLOCK);
+            void          setRange(uint32_t minClock, uint32_t maxClock);
+            void          setMargin(byte steps);
+            void          setTestReads(unsigned int reads);
+            void          setInterval(unsigned long interval);    // re-check period in mS (0 = never)
+            bool          tune();                                 // false if unsupported or the lowest rate fails
+            bool          update();                               // true when a re-check changed the clock
+            uint32_t      getClock();                             // 0 before tune()
+            unsigned int  getRetunes();
+        private:
+            MCP3221       &_device;
+            uint32_t       _minClock, _maxClock, _clock;
+            byte           _margin;
+            unsigned int   _testReads, _retunes;
+            unsigned long  _interval, _lastCheck;
+            bool           testClock();
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
@@ -43,7 +43,7 @@ __asm volatile ("nop");
 
 namespace Mcp3221 {
 
-    const byte COM_BUFFER_SIZE  = 60;
+    const byte COM_BUFFER_SIZE  = 60;                           // buffer size needed for MCP3221ComStr()
     const int  NUM_OF_COM_CODES =  8;
 
     const char comMsg0[] PROGMEM = "Success";
@@ -53,7 +53,8 @@ namespace Mcp3221 {
     const char comMsg4[] PROGMEM = "Error Code #4: Other error (bus error, etc.)";
     const char comMsg5[] PROGMEM = "Error Code #5: Timed-out while trying to become Bus Master";
     const char comMsg6[] PROGMEM = "Error Code #6: Timed-out while waiting for data to be sent";
-    const char comMsgDefault[] PROGMEM = "Error Code #%d: Unlisted error";
+    const char comMsgDefault[] PROGMEM = "Error Code #";
+    const char comMsgUnlisted[] PROGMEM = ": Unlisted error";
 
     const char * const comCodes[NUM_OF_COM_CODES] PROGMEM = {
             comMsg0,
@@ -67,18 +68,44 @@ namespace Mcp3221 {
     };
 
 /*==============================================================================================================*
-    GET I2C COMMUNICATIONS RESULT MESSAGE (PRINTABLE FORMAT)
+    PRINT I2C COMMUNICATIONS RESULT MESSAGE (STREAMED FROM PROGMEM, NO BUFFERS)
  *==============================================================================================================*/
 
-    MCP3221_PString MCP3221ComStr(const MCP3221& devParams) {
-        char devComBuffer[COM_BUFFER_SIZE];
-        MCP3221_PString comStr(devComBuffer, COM_BUFFER_SIZE);
-        char comCodeResult = devParams._comBuffer;
-        char * ptr = (char *) pgm_read_word(&comCodes[comCodeResult]);
-        snprintf_P(devComBuffer, COM_BUFFER_SIZE, ptr, comCodeResult);
+    inline size_t MCP3221PrintComCode(Print &out, byte comCode) {
+        byte index = (comCode < (NUM_OF_COM_CODES - 1)) ? comCode : (NUM_OF_COM_CODES - 1);
+        size_t n = out.print((const __FlashStringHelper *) pgm_read_word(&comCodes[index]));
+        if (index == (NUM_OF_COM_CODES - 1)) {
+            n += out.print(comCode);
+            n += out.print((const __FlashStringHelper *) comMsgUnlisted);
+        }
+        return n;
+    }
+
+    inline size_t MCP3221PrintComStatus(const MCP3221& devParams, Print &out) {
+        return MCP3221PrintComCode(out, devParams._comBuffer);
+    }
+
+/*==============================================================================================================*
+    GET I2C COMMUNICATIONS RESULT MESSAGE (PRINTABLE FORMAT, IN A CALLER-PROVIDED BUFFER)
+ *==============================================================================================================*/
+
+    inline MCP3221_PString MCP3221ComStr(const MCP3221& devParams, char *buffer, size_t size) {
+        MCP3221_PString comStr(buffer, size);
+        MCP3221PrintComStatus(devParams, comStr);
         return comStr;
     }
 
+/*==============================================================================================================*
+    GET I2C COMMUNICATIONS RESULT MESSAGE (PRINTABLE FORMAT, IN A SHARED STATIC BUFFER)
+ *==============================================================================================================*/
+
+// Original one-argument form: the text stays valid until the next call.
+
+    inline MCP3221_PString MCP3221ComStr(const MCP3221& devParams) {
+        static char devComBuffer[COM_BUFFER_SIZE];
+        return MCP3221ComStr(devParams, devComBuffer, COM_BUFFER_SIZE);
+    }
+
 }
 
 using namespace Mcp3221;
@@ -0,0 +1,171 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Filters.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221Filters.h"
+
+/*==============================================================================================================*
+    FILTER PIPELINE STAGE (DEFAULT BLOCK PROCESSING: PER-SAMPLE, DROPPED SAMPLES ARE SQUEEZED OUT)
+ *==============================================================================================================*/
+
+size_t MCP3221Stage::processBlock(uint16_t *samples, size_t count) {
+    size_t numOut = 0;
+    for (size_t i=0; i<count; i++) {
+        unsigned int sample = samples[i];
+        if (process(sample)) samples[numOut++] = sample;
+    }
+    return numOut;
+}
+
+/*==============================================================================================================*
+    EXPONENTIAL MOVING AVERAGE STAGE
+ *==============================================================================================================*/
+
+MCP3221Ema::MCP3221Ema(unsigned int alpha) {
+    _core.setAlpha(alpha);
+    _core.reset();
+}
+
+void MCP3221Ema::setAlpha(unsigned int alpha) {
+    _core.setAlpha(alpha);
+}
+
+unsigned int MCP3221Ema::getAlpha() const {
+    return _core.getAlpha();
+}
+
+bool MCP3221Ema::process(unsigned int &sample) {
+    sample = _core.update(sample);
+    return true;
+}
+
+size_t MCP3221Ema::processBlock(uint16_t *samples, size_t count) {
+    for (size_t i=0; i<count; i++) samples[i] = _core.update(samples[i]);
+    return count;
+}
+
+void MCP3221Ema::reset() {
+    _core.reset();
+}
+
+/*==============================================================================================================*
+    DECIMATOR STAGE
+ *==============================================================================================================*/
+
+MCP3221Decimator::MCP3221Decimator(byte factor) :
+    _factor(max(factor, 1))
+    {
+        reset();
+    }
+
+byte MCP3221Decimator::getFactor() const {
+    return _factor;
+}
+
+bool MCP3221Decimator::process(unsigned int &sample) {
+    _sum += sample;
+    if (++_count < _factor) return false;
+    sample = (_sum + (_factor >> 1)) / _factor;
+    _sum = 0;
+    _count = 0;
+    return true;
+}
+
+size_t MCP3221Decimator::processBlock(uint16_t *samples, size_t count) {
+    size_t numOut = 0;
+    for (size_t i=0; i<count; i++) {
+        _sum += samples[i];
+        if (++_count < _factor) continue;
+        samples[numOut++] = (_sum + (_factor >> 1)) / _factor;                  // output never overtakes input
+        _sum = 0;
+        _count = 0;
+    }
+    return numOut;
+}
+
+void MCP3221Decimator::reset() {
+    _sum = 0;
+    _count = 0;
+}
+
+/*==============================================================================================================*
+    HAMPEL SPIKE FILTER
+ *==============================================================================================================*/
+
+MCP3221Hampel::MCP3221Hampel(byte window, byte threshold, unsigned int minDeviation) :
+    _size(min(window | 1, MAX_MEDIAN_WINDOW)),
+    _threshold(threshold),
+    _minDeviation(minDeviation)
+    {
+        reset();
+    }
+
+bool MCP3221Hampel::process(unsigned int &sample) {
+    sample = filter(sample);
+    return true;
+}
+
+size_t MCP3221Hampel::processBlock(uint16_t *samples, size_t count) {
+    for (size_t i=0; i<count; i++) samples[i] = filter(samples[i]);
+    return count;
+}
+
+unsigned int MCP3221Hampel::filter(unsigned int sample) {
+    uint16_t sorted[MAX_MEDIAN_WINDOW];
+    _window[_index] = sample;
+    if (++_index >= _size) _index = 0;
+    if (_count < _size) _count++;
+    if (_count < 3) return sample;                                              // too few samples to judge
+    for (byte i=0; i<_count; i++) sorted[i] = _window[i];
+    unsigned int median = MCP3221_median(sorted, _count);
+    for (byte i=0; i<_count; i++) sorted[i] = (sorted[i] > median) ? (sorted[i] - median) : (median - sorted[i]);
+    unsigned long limit = ((unsigned long)_threshold * 3 * MCP3221_median(sorted, _count)) >> 1;
+    if (limit < _minDeviation) limit = _minDeviation;
+    unsigned int deviation = (sample > median) ? (sample - median) : (median - sample);
+    if (deviation <= limit) return sample;
+    _rejected++;
+    return median;
+}
+
+unsigned long MCP3221Hampel::getRejected() {
+    return _rejected;
+}
+
+void MCP3221Hampel::reset() {
+    _index = _count = 0;
+    _rejected = 0;
+}
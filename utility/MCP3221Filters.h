@@ -0,0 +1,197 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Filters.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Filters_h
+#define MCP3221Filters_h
+
+#include "MCP3221.h"
+
+namespace Mcp3221 {
+
+    const byte         DEFAULT_HAMPEL_WINDOW    = 5;    // samples (odd, up to MAX_MEDIAN_WINDOW)
+    const byte         DEFAULT_HAMPEL_THRESHOLD = 3;    // outlier limit in (scaled) median absolute deviations
+    const unsigned int DEFAULT_HAMPEL_MIN_DEV   = 4;    // outlier limit floor in counts (for a perfectly flat window)
+
+/*==============================================================================================================*
+    FILTER PIPELINE STAGE (BASE CLASS)
+ *==============================================================================================================*/
+
+// Stages are chained onto a device with addStage() and run in the order they were added, ahead of the built-in
+// smoothing method. process() filters one sample in place and returns false if the stage consumed it (e.g. a
+// decimator between outputs); processBlock() filters a buffer in place and returns the number of samples left.
+// The default processBlock() calls process() per sample; the stages below override it with a non-virtual loop
+// so that burst and queued reads pay one virtual call per stage per block. Stages hold their own (statically
+// sized) state, so a stage instance belongs to a single device.
+
+    class MCP3221Stage {
+        public:
+            MCP3221Stage() : _next(NULL) {}
+            virtual bool   process(unsigned int &sample) = 0;
+            virtual size_t processBlock(uint16_t *samples, size_t count);
+            virtual void   reset() {}
+        private:
+            MCP3221Stage  *_next;                           // next stage in the pipeline (managed by addStage())
+            friend class   MCP3221;
+    };
+
+/*==============================================================================================================*
+    ROLLING-AVERAGE STAGE (WINDOW: 1-255 SAMPLES, POWER OF TWO DIVIDES BY SHIFT)
+ *==============================================================================================================*/
+
+    template <byte WINDOW>
+    class MCP3221RollingAvg : public MCP3221Stage {
+        static_assert(WINDOW > 0, "MCP3221RollingAvg: WINDOW must be at least 1");
+        public:
+            MCP3221RollingAvg() {
+                reset();
+            }
+            bool process(unsigned int &sample) {
+                _core.push(_samples, sample);
+                sample = _core.average();
+                return true;
+            }
+            size_t processBlock(uint16_t *samples, size_t count) {
+                for (size_t i=0; i<count; i++) {
+                    _core.push(_samples, samples[i]);
+                    samples[i] = _core.average();
+                }
+                return count;
+            }
+            void reset() {
+                _core.reset(WINDOW);
+            }
+        private:
+            MCP3221_WindowCore _core;
+            uint16_t           _samples[WINDOW];
+    };
+
+/*==============================================================================================================*
+    MEDIAN STAGE (WINDOW: ODD, UP TO MAX_MEDIAN_WINDOW SAMPLES)
+ *==============================================================================================================*/
+
+    template <byte WINDOW>
+    class MCP3221Median : public MCP3221Stage {
+        static_assert((WINDOW & 1) && (WINDOW <= MAX_MEDIAN_WINDOW), "MCP3221Median: WINDOW must be odd & <= 9");
+        public:
+            MCP3221Median() {
+                reset();
+            }
+            bool process(unsigned int &sample) {
+                _core.push(_samples, sample);
+                sample = _core.median(_samples);
+                return true;
+            }
+            size_t processBlock(uint16_t *samples, size_t count) {
+                for (size_t i=0; i<count; i++) {
+                    _core.push(_samples, samples[i]);
+                    samples[i] = _core.median(_samples);
+                }
+                return count;
+            }
+            void reset() {
+                _core.reset(WINDOW);
+            }
+        private:
+            MCP3221_WindowCore _core;
+            uint16_t           _samples[WINDOW];
+    };
+
+/*==============================================================================================================*
+    EXPONENTIAL MOVING AVERAGE STAGE (ALPHA: 1-256, alpha/256 PER SAMPLE)
+ *==============================================================================================================*/
+
+    class MCP3221Ema : public MCP3221Stage {
+        public:
+            MCP3221Ema(unsigned int alpha = DEFAULT_ALPHA);
+            void           setAlpha(unsigned int alpha);
+            unsigned int   getAlpha() const;
+            bool           process(unsigned int &sample);
+            size_t         processBlock(uint16_t *samples, size_t count);
+            void           reset();
+        private:
+            MCP3221_EmaCore _core;
+    };
+
+/*==============================================================================================================*
+    DECIMATOR STAGE (MEAN OF EACH GROUP OF 'FACTOR' SAMPLES, ONE OUTPUT PER GROUP)
+ *==============================================================================================================*/
+
+// Averaging before dropping samples keeps the decimated stream free of aliasing from noise above the new rate.
+// Partial groups carry over between calls, so a block of any length can be passed in.
+
+    class MCP3221Decimator : public MCP3221Stage {
+        public:
+            MCP3221Decimator(byte factor);
+            byte           getFactor() const;
+            bool           process(unsigned int &sample);
+            size_t         processBlock(uint16_t *samples, size_t count);
+            void           reset();
+        private:
+            byte           _factor, _count;
+            unsigned long  _sum;
+    };
+
+/*==============================================================================================================*
+    HAMPEL SPIKE FILTER (OUTLIER REJECTION AHEAD OF THE SMOOTHING METHOD)
+ *==============================================================================================================*/
+
+// Each sample is compared with the median of the latest window: if it lies further away than 'threshold' times
+// the median absolute deviation (scaled by 1.5 to estimate the standard deviation), it is replaced by the median.
+// Isolated spikes (e.g. from relay switching) are removed while steps pass through once they fill half the window.
+// Cost per sample is two insertion sorts of at most MAX_MEDIAN_WINDOW values. Attach with addStage().
+
+    class MCP3221Hampel : public MCP3221Stage {
+        public:
+            MCP3221Hampel(byte window = DEFAULT_HAMPEL_WINDOW, byte threshold = DEFAULT_HAMPEL_THRESHOLD,
+                          unsigned int minDeviation = DEFAULT_HAMPEL_MIN_DEV);
+            bool          process(unsigned int &sample);
+            size_t        processBlock(uint16_t *samples, size_t count);
+            unsigned long getRejected();                    // number of samples replaced so far
+            void          reset();
+        private:
+            unsigned int  filter(unsigned int sample);
+            uint16_t      _window[MAX_MEDIAN_WINDOW];
+            byte          _size, _index, _count, _threshold;
+            unsigned int  _minDeviation;
+            unsigned long _rejected;
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
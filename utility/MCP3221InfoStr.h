@@ -44,20 +44,21 @@ __asm volatile ("nop");
 
 namespace Mcp3221 {
 
-    const int  INFO_BUFFER_SIZE = 60;
+    const int  INFO_BUFFER_SIZE = 360;                          // buffer size needed for MCP3221InfoStr()
     const byte NUM_OF_INFO_STR  = 12;
+    const byte NUM_OF_SMOOTH_STR = 5;
 
     const char infoStr0[]  PROGMEM = "\nMCP3221 DEVICE INFORMATION";
     const char infoStr1[]  PROGMEM = "\n--------------------------";
-    const char infoStr2[]  PROGMEM = "\nI2C ADDRESS:\t   %d (%#X)";
-    const char infoStr3[]  PROGMEM = "\nI2C COM STATUS:\t   %sCONNECTED";
-    const char infoStr4[]  PROGMEM = "\nVOLTAGE REFERENCE: %dmV";
-    const char infoStr5[]  PROGMEM = "\nSMOOTHING METHOD:  %s";
-    const char infoStr6[]  PROGMEM = "\nVOLTAGE INPUT:\t   %dV";
-    const char infoStr7[]  PROGMEM = "\nVD RESISTOR 1:\t   %dR";
-    const char infoStr8[]  PROGMEM = "\nVD RESISTOR 2:\t   %dR";
-    const char infoStr9[]  PROGMEM = "\nALPHA:\t\t   %d";
-    const char infoStr10[] PROGMEM = "\nSAMPLES BUFFER:\t   %d SAMPLES\n";
+    const char infoStr2[]  PROGMEM = "\nI2C ADDRESS:\t   ";
+    const char infoStr3[]  PROGMEM = "\nI2C COM STATUS:\t   ";
+    const char infoStr4[]  PROGMEM = "\nVOLTAGE REFERENCE: ";
+    const char infoStr5[]  PROGMEM = "\nSMOOTHING METHOD:  ";
+    const char infoStr6[]  PROGMEM = "\nVOLTAGE INPUT:\t   ";
+    const char infoStr7[]  PROGMEM = "\nVD RESISTOR 1:\t   ";
+    const char infoStr8[]  PROGMEM = "\nVD RESISTOR 2:\t   ";
+    const char infoStr9[]  PROGMEM = "\nALPHA:\t\t   ";
+    const char infoStr10[] PROGMEM = "\nSAMPLES BUFFER:\t   ";
     const char errStr[]    PROGMEM = "\nI2C ERROR:\t ";
 
     const char * const infoStrs[NUM_OF_INFO_STR] PROGMEM = {
@@ -75,52 +76,85 @@ namespace Mcp3221 {
         errStr
     };
 
+    const char smoothStr0[] PROGMEM = "NO SMOOTHING";
+    const char smoothStr1[] PROGMEM = "ROLLING-AVAREGE";
+    const char smoothStr2[] PROGMEM = "EMAVG";
+    const char smoothStr3[] PROGMEM = "MEDIAN";
+    const char smoothStr4[] PROGMEM = "UNKNOWN";
+
+    const char * const smoothStrs[NUM_OF_SMOOTH_STR] PROGMEM = {
+        smoothStr0,
+        smoothStr1,
+        smoothStr2,
+        smoothStr3,
+        smoothStr4
+    };
+
 /*==============================================================================================================*
-    GENERATE DEVICE INFORMATION STRING (PRINTABLE FORMAT)
+    PRINT DEVICE INFORMATION (STREAMED FROM PROGMEM, NO BUFFERS)
  *==============================================================================================================*/
 
-    MCP3221_PString MCP3221InfoStr(const MCP3221& devParams) {
-        char * ptr;
-        char strBuffer[360];    // 338
-        char devInfoBuffer[INFO_BUFFER_SIZE];
-        MCP3221_PString resultStr(strBuffer, sizeof(strBuffer));
-        MCP3221 mcp3221(devParams._devAddr);
-        byte comErrCode = mcp3221.ping();
-        unsigned int res1 = mcp3221.getRes1();
-        unsigned int res2 = mcp3221.getRes2();
-        
-        for (byte i=0; i<4; i++) {
-            ptr = (char *) pgm_read_word(&infoStrs[i]);
-            if (i < 2)   snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr);
-            if (i == 2)  snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, devParams._devAddr, devParams._devAddr);
-            if (i == 3)  snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, (comErrCode ? "NOT " : ""));
-            resultStr += devInfoBuffer;
-        }
+    inline size_t MCP3221PrintInfo(const MCP3221& devParams, Print &out) {
+        size_t n = 0;
+        devParams._bus->beginTransmission(devParams._devAddr);                  // ping without altering the device
+        byte comErrCode = devParams._bus->endTransmission();
+        for (byte i=0; i<3; i++) n += out.print((const __FlashStringHelper *) pgm_read_word(&infoStrs[i]));
+        n += out.print(devParams._devAddr);
+        n += out.print(F(" (0X"));
+        n += out.print(devParams._devAddr, HEX);
+        n += out.print(F(")"));
+        n += out.print((const __FlashStringHelper *) infoStr3);
+        n += out.print(comErrCode ? F("NOT CONNECTED") : F("CONNECTED"));
         if (!comErrCode) {
-            for (byte i=4; i<(NUM_OF_INFO_STR - 1); i++) {
-                ptr = (char *) pgm_read_word(&infoStrs[i]);
-                if (i == 4)  snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, devParams._vRef);
-                if (i == 5)  switch (devParams._smoothing) {
-                                case (NO_SMOOTHING): snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, "NO SMOOTHING"); break;
-                                case (ROLLING_AVG):  snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, "ROLLING-AVAREGE"); break;
-                                case (EMAVG):        snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, "EMAVG"); break;
-                            }
-                if (i == 6)  snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, (devParams._voltageInput ? 12 : 5));
-                if (i == 7)  snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, devParams._res1);
-                if (i == 8)  snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, devParams._res2);
-                if (i == 9)  snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, devParams._alpha);
-                if (i == 10) snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, ptr, devParams._numSamples);
-                if (i != 11) resultStr += devInfoBuffer;
-            }
+            n += out.print((const __FlashStringHelper *) infoStr4);
+            n += out.print(devParams._vRef);
+            n += out.print(F("mV"));
+            byte smoothing = min(devParams._smoothing, (byte)(NUM_OF_SMOOTH_STR - 1));
+            n += out.print((const __FlashStringHelper *) infoStr5);
+            n += out.print((const __FlashStringHelper *) pgm_read_word(&smoothStrs[smoothing]));
+            n += out.print((const __FlashStringHelper *) infoStr6);
+            n += out.print(devParams._voltageInput ? 12 : 5);
+            n += out.print(F("V"));
+            n += out.print((const __FlashStringHelper *) infoStr7);
+            n += out.print(devParams._res1);
+            n += out.print(F("R"));
+            n += out.print((const __FlashStringHelper *) infoStr8);
+            n += out.print(devParams._res2);
+            n += out.print(F("R"));
+            n += out.print((const __FlashStringHelper *) infoStr9);
+            n += out.print(devParams._ema.getAlpha());
+            n += out.print((const __FlashStringHelper *) infoStr10);
+            n += out.print(devParams._numSamples);
+            n += out.print(F(" SAMPLES\n"));
         } else {
-            snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, (char *) pgm_read_word(&infoStrs[11]));
-            resultStr += devInfoBuffer;
-            snprintf_P(devInfoBuffer, INFO_BUFFER_SIZE, (char *) pgm_read_word(&comCodes[comErrCode]));
-            resultStr += devInfoBuffer;
-            resultStr += "\n";
+            n += out.print((const __FlashStringHelper *) errStr);
+            n += MCP3221PrintComCode(out, comErrCode);
+            n += out.print(F("\n"));
         }
+        return n;
+    }
+
+/*==============================================================================================================*
+    GENERATE DEVICE INFORMATION STRING (PRINTABLE FORMAT, IN A CALLER-PROVIDED BUFFER)
+ *==============================================================================================================*/
+
+    inline MCP3221_PString MCP3221InfoStr(const MCP3221& devParams, char *buffer, size_t size) {
+        MCP3221_PString resultStr(buffer, size);
+        MCP3221PrintInfo(devParams, resultStr);
         return resultStr;
     }
+
+/*==============================================================================================================*
+    GENERATE DEVICE INFORMATION STRING (PRINTABLE FORMAT, IN A SHARED STATIC BUFFER)
+ *==============================================================================================================*/
+
+// Original one-argument form: the text stays valid until the next call. The buffer is only linked in when this
+// overload is used.
+
+    inline MCP3221_PString MCP3221InfoStr(const MCP3221& devParams) {
+        static char devInfoBuffer[INFO_BUFFER_SIZE];
+        return MCP3221InfoStr(devParams, devInfoBuffer, INFO_BUFFER_SIZE);
+    }
 }
 
 using namespace Mcp3221;
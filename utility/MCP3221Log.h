@@ -0,0 +1,233 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Log.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#ifndef MCP3221Log_h
+#define MCP3221Log_h
+
+#include <stdint.h>                                     // no Arduino dependencies: shared with the host decoder
+
+/*==============================================================================================================*
+    LOG FORMAT
+ *==============================================================================================================*
+
+    A log is a sequence of blocks, each made of a 10-byte header followed by up to 'count' samples:
+
+        0xA5 0x5A | FLAGS | ADDRESS | COUNT | TIMESTAMP (4 bytes, LSB first) | CHECK (XOR of the 7 bytes before)
+
+    FLAGS holds the format version in its upper nibble and the sample encoding in its lower nibble:
+
+        LOG_PACKED - two 12-bit samples in 3 bytes: [a11..a4] [a3..a0 b11..b8] [b7..b0]
+                     (a block ending on an odd sample closes with [a11..a4] [a3..a0 0000])
+        LOG_DELTA  - each sample as the zigzag-encoded difference from the previous one in 7-bit varint
+                     form (1 byte for changes of -64 to +63 counts, never more than 2 bytes); the first
+                     sample of a block is relative to 0
+
+    Only the last block of a log may hold fewer than 'count' samples (it ends where the data ends). A decoder
+    joining mid-stream looks for the sync bytes and uses the check byte to reject false matches.
+
+ *==============================================================================================================*/
+
+namespace Mcp3221 {
+
+    const uint8_t LOG_SYNC_1        = 0xA5;
+    const uint8_t LOG_SYNC_2        = 0x5A;
+    const uint8_t LOG_VERSION       =    1;
+    const uint8_t LOG_HEADER_BYTES  =   10;
+    const uint8_t LOG_DEFAULT_BLOCK =   64;             // samples between sync headers
+
+    typedef enum:uint8_t {
+        LOG_PACKED = 0,     // default
+        LOG_DELTA  = 1
+    } log_mode_t;
+
+/*==============================================================================================================*
+    LOG ENCODER (SINK: ANY OBJECT WITH write(uint8_t), E.G. Serial OR A FILE WRAPPER)
+ *==============================================================================================================*/
+
+    template<class SINK> class MCP3221LogEncoder {
+        public:
+            MCP3221LogEncoder(SINK &sink, uint8_t devAddr, log_mode_t mode = LOG_PACKED,
+                              uint8_t blockSize = LOG_DEFAULT_BLOCK) :
+                _sink(sink),
+                _devAddr(devAddr),
+                _mode(mode),
+                _blockSize(blockSize ? blockSize : 1),
+                _index(0),
+                _nibble(0),
+                _prev(0) {}
+            void write(uint16_t sample, uint32_t timestamp) {           // timestamp is logged at block starts
+                if (!_index) writeHeader(timestamp);
+                sample &= 0x0FFF;
+                if (_mode == LOG_DELTA) {
+                    int16_t delta = sample - _prev;
+                    writeVarint((delta < 0) ? (((uint16_t)-delta << 1) - 1) : ((uint16_t)delta << 1));   // zigzag
+                    _prev = sample;
+                } else if (!(_index & 1)) {
+                    _sink.write(sample >> 4);
+                    _nibble = sample & 0x0F;
+                    if (_index == _blockSize - 1) _sink.write(_nibble << 4);
+                } else {
+                    _sink.write((_nibble << 4) | (sample >> 8));
+                    _sink.write(sample & 0xFF);
+                }
+                if (++_index == _blockSize) _index = 0;
+            }
+            void end() {                                                // completes a half-written pair
+                if ((_mode == LOG_PACKED) && (_index & 1)) _sink.write(_nibble << 4);
+                _index = 0;
+            }
+        private:
+            void writeHeader(uint32_t timestamp) {
+                uint8_t header[LOG_HEADER_BYTES] = {
+                    LOG_SYNC_1, LOG_SYNC_2, (uint8_t)((LOG_VERSION << 4) | _mode), _devAddr, _blockSize,
+                    (uint8_t)timestamp, (uint8_t)(timestamp >> 8), (uint8_t)(timestamp >> 16),
+                    (uint8_t)(timestamp >> 24), 0
+                };
+                for (uint8_t i=2; i<(LOG_HEADER_BYTES - 1); i++) header[LOG_HEADER_BYTES - 1] ^= header[i];
+                for (uint8_t i=0; i<LOG_HEADER_BYTES; i++) _sink.write(header[i]);
+                _prev = 0;
+            }
+            void writeVarint(uint16_t value) {
+                while (value > 0x7F) {
+                    _sink.write((value & 0x7F) | 0x80);
+                    value >>= 7;
+                }
+                _sink.write(value);
+            }
+            SINK    &_sink;
+            uint8_t  _devAddr, _mode, _blockSize, _index, _nibble;
+            uint16_t _prev;
+    };
+
+/*==============================================================================================================*
+    LOG DECODER (FED ONE BYTE AT A TIME, YIELDS AT MOST ONE SAMPLE PER BYTE)
+ *==============================================================================================================*/
+
+    class MCP3221LogDecoder {
+        public:
+            MCP3221LogDecoder() :
+                _state(FIND_SYNC_1),
+                _pos(0),
+                _check(0),
+                _index(0),
+                _header(),
+                _value(0),
+                _sample(0),
+                _syncErrors(0) {}
+            bool feed(uint8_t data) {                                   // true when a sample is ready
+                switch (_state) {
+                    case FIND_SYNC_1:
+                        if (data == LOG_SYNC_1) _state = FIND_SYNC_2;
+                        return false;
+                    case FIND_SYNC_2:
+                        _state = (data == LOG_SYNC_2) ? READ_HEADER : (data == LOG_SYNC_1) ? FIND_SYNC_2 : FIND_SYNC_1;
+                        _pos = _check = 0;
+                        return false;
+                    case READ_HEADER:
+                        if (_pos < (LOG_HEADER_BYTES - 3)) {
+                            _header[_pos++] = data;
+                            _check ^= data;
+                            return false;
+                        }
+                        if ((data != _check) || ((_header[0] >> 4) != LOG_VERSION) || ((_header[0] & 0x0F) > LOG_DELTA) || !_header[2]) {
+                            uint8_t rejected[LOG_HEADER_BYTES - 2];             // false sync: rescan what it swallowed
+                            for (uint8_t i=0; i<(LOG_HEADER_BYTES - 3); i++) rejected[i] = _header[i];
+                            rejected[LOG_HEADER_BYTES - 3] = data;
+                            _syncErrors++;
+                            _state = FIND_SYNC_1;
+                            for (uint8_t i=0; i<(LOG_HEADER_BYTES - 2); i++) feed(rejected[i]);
+                            return false;
+                        }
+                        _index = _pos = 0;
+                        _value = 0;
+                        _sample = 0;
+                        _state = READ_DATA;
+                        return false;
+                    default:
+                        return (_header[0] & 0x0F) == LOG_DELTA ? readDelta(data) : readPacked(data);
+                }
+            }
+            uint16_t getSample()     { return _sample; }
+            uint8_t  getAddress()    { return _header[1]; }
+            uint8_t  getBlockSize()  { return _header[2]; }
+            uint8_t  getIndex()      { return _index - 1; }             // of the latest sample within its block
+            uint8_t  getMode()       { return _header[0] & 0x0F; }
+            uint32_t getTimestamp()  {                                  // of the latest sample's block
+                return _header[3] | ((uint32_t)_header[4] << 8) | ((uint32_t)_header[5] << 16) | ((uint32_t)_header[6] << 24);
+            }
+            uint32_t getSyncErrors() { return _syncErrors; }            // rejected headers & malformed samples
+        private:
+            enum { FIND_SYNC_1, FIND_SYNC_2, READ_HEADER, READ_DATA };
+            bool readPacked(uint8_t data) {
+                bool ready = false;
+                if (_pos == 0) {
+                    _value = data << 4;
+                } else if (_pos == 1) {
+                    _sample = _value | (data >> 4);
+                    _value = (data & 0x0F) << 8;
+                    ready = true;
+                } else {
+                    _sample = _value | data;
+                    ready = true;
+                }
+                _pos = (_pos == 2) ? 0 : (_pos + 1);
+                return ready && sampleDone();
+            }
+            bool readDelta(uint8_t data) {
+                if (_pos == 2) {                                        // no valid sample takes 3 bytes
+                    _syncErrors++;
+                    _state = FIND_SYNC_1;
+                    return false;
+                }
+                _value |= (uint16_t)(data & 0x7F) << (7 * _pos++);
+                if (data & 0x80) return false;
+                _sample = (_sample + (int16_t)((_value >> 1) ^ -(_value & 1))) & 0x0FFF;
+                _value = _pos = 0;
+                return sampleDone();
+            }
+            bool sampleDone() {
+                if (++_index == _header[2]) _state = FIND_SYNC_1;
+                if (_state == FIND_SYNC_1) _pos = 0;
+                return true;
+            }
+            uint8_t  _state, _pos, _check, _index;
+            uint8_t  _header[LOG_HEADER_BYTES - 3];                     // flags, address, count, timestamp
+            uint16_t _value, _sample;
+            uint32_t _syncErrors;
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
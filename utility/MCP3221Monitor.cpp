@@ -0,0 +1,138 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Monitor.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221Monitor.h"
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221Monitor::MCP3221Monitor(MCP3221 &device, unsigned int deadband, unsigned int hysteresis) :
+    _device(device),
+    _value(0),
+    _minInterval(DEFAULT_MIN_INTERVAL),
+    _maxInterval(DEFAULT_MAX_INTERVAL)
+    {
+        setDeadband(deadband, hysteresis);
+        reset();
+    }
+
+/*==============================================================================================================*
+    SET DEADBAND & HYSTERESIS (IN COUNTS, HYSTERESIS IS LIMITED TO THE DEADBAND)
+ *==============================================================================================================*/
+
+void MCP3221Monitor::setDeadband(unsigned int deadband, unsigned int hysteresis) {
+    _deadband = deadband;
+    _hysteresis = min(hysteresis, deadband);
+}
+
+/*==============================================================================================================*
+    SET POLLING INTERVAL RANGE (IN mS, THE MAXIMUM IS AT LEAST 1mS SO THAT BACKING OFF ALWAYS SLOWS POLLING)
+ *==============================================================================================================*/
+
+void MCP3221Monitor::setInterval(unsigned long minInterval, unsigned long maxInterval) {
+    _minInterval = minInterval;
+    _maxInterval = max(max(minInterval, maxInterval), 1UL);
+    _interval = constrain(_interval, _minInterval, _maxInterval);
+}
+
+/*==============================================================================================================*
+    UPDATE (POLLS THE DEVICE WHEN THE CURRENT INTERVAL HAS ELAPSED)
+ *==============================================================================================================*/
+
+bool MCP3221Monitor::update() {
+    if (millis() - _lastPoll < _interval) return false;
+    _lastPoll = millis();
+    unsigned int data;
+    if (_device.readData(data) != SAMPLE_VALID) {                              // failed reads are never reported
+        backOff();                                                              // and don't retry on every pass
+        return false;
+    }
+    unsigned int change = (data > _value) ? (data - _value) : (_value - data);
+    if (!_primed || (change > (_active ? (_deadband - _hysteresis) : _deadband))) {
+        _value = data;
+        _primed = _active = true;
+        _interval = _minInterval;
+        return true;
+    }
+    backOff();
+    return false;
+}
+
+/*==============================================================================================================*
+    GET LATEST REPORTED VALUE
+ *==============================================================================================================*/
+
+unsigned int MCP3221Monitor::getValue() {
+    return _value;
+}
+
+/*==============================================================================================================*
+    GET CURRENT POLLING INTERVAL (IN mS)
+ *==============================================================================================================*/
+
+unsigned long MCP3221Monitor::getInterval() {
+    return _interval;
+}
+
+/*==============================================================================================================*
+    IS ACTIVE (TRUE WHILE THE SIGNAL IS CHANGING)
+ *==============================================================================================================*/
+
+bool MCP3221Monitor::isActive() {
+    return _active;
+}
+
+/*==============================================================================================================*
+    RESET
+ *==============================================================================================================*/
+
+void MCP3221Monitor::reset() {
+    _primed = _active = false;
+    _interval = _minInterval;
+    _lastPoll = millis() - _interval;                                           // first update() polls at once
+}
+
+/*==============================================================================================================*
+    BACK OFF (DOUBLES THE POLLING INTERVAL UP TO THE MAXIMUM)
+ *==============================================================================================================*/
+
+void MCP3221Monitor::backOff() {
+    _active = false;
+    _interval = min(max(_interval * 2, 1UL), _maxInterval);
+}
@@ -0,0 +1,82 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Monitor.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Monitor_h
+#define MCP3221Monitor_h
+
+#include "MCP3221.h"
+
+namespace Mcp3221 {
+
+    const unsigned int  DEFAULT_DEADBAND     =    8;    // change (in counts) needed to report while idle
+    const unsigned int  DEFAULT_HYSTERESIS   =    4;    // deadband reduction while the signal is changing
+    const unsigned long DEFAULT_MIN_INTERVAL =   10;    // polling interval while the signal is changing (in mS)
+    const unsigned long DEFAULT_MAX_INTERVAL = 1000;    // polling interval limit while the signal is stable (in mS)
+
+/*==============================================================================================================*
+    CHANGE MONITOR (DEADBAND REPORTING WITH ADAPTIVE POLLING RATE)
+ *==============================================================================================================*/
+
+// A reading is reported only when it differs from the last reported value by more than the deadband. Once the
+// signal is moving the deadband shrinks by the hysteresis, so a slow ramp is tracked without gaps, and widens
+// again on the first quiet poll, so noise around a settled value isn't reported. Each quiet poll doubles the
+// polling interval (up to the maximum); a reported change drops it back to the minimum.
+
+    class MCP3221Monitor {
+        public:
+            MCP3221Monitor(MCP3221 &device, unsigned int deadband = DEFAULT_DEADBAND,
+                           unsigned int hysteresis = DEFAULT_HYSTERESIS);
+            void          setDeadband(unsigned int deadband, unsigned int hysteresis = DEFAULT_HYSTERESIS);
+            void          setInterval(unsigned long minInterval, unsigned long maxInterval);
+            bool          update();                         // call often: true when a new value is reported
+            unsigned int  getValue();                       // latest reported value
+            unsigned long getInterval();                    // current polling interval (in mS)
+            bool          isActive();                       // true while the signal is changing
+            void          reset();                          // reports the next reading & restores the minimum interval
+        private:
+            MCP3221       &_device;
+            unsigned int   _deadband, _hysteresis, _value;
+            unsigned long  _minInterval, _maxInterval, _interval, _lastPoll;
+            bool           _active, _primed;
+            void           backOff();
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
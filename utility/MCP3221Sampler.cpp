@@ -0,0 +1,196 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Sampler.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221Sampler.h"
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221Sampler::MCP3221Sampler(MCP3221 &device, unsigned long rate) :
+    _device(device),
+    _fraction(0),
+    _deadline(0),
+    _tickTime(0),
+    _ticks(0),
+    _timerDriven(false),
+    _started(false)
+    {
+        setRate(rate);
+        resetJitterStats();
+    }
+
+/*==============================================================================================================*
+    BEGIN
+ *==============================================================================================================*/
+
+void MCP3221Sampler::begin() {
+    _deadline = micros();
+    _fraction = 0;
+    advance(1);
+    _ticks = 0;
+    _started = true;
+}
+
+/*==============================================================================================================*
+    SET RATE (SAMPLES PER SECOND, 1 - 1000000)
+ *==============================================================================================================*/
+
+void MCP3221Sampler::setRate(unsigned long rate) {
+    _rate = constrain(rate, 1UL, 1000000UL);
+    _period = 1000000UL / _rate;
+    _remainder = 1000000UL % _rate;                                        // carried by advance()
+    _fraction = 0;
+}
+
+/*==============================================================================================================*
+    GET RATE (SAMPLES PER SECOND)
+ *==============================================================================================================*/
+
+unsigned long MCP3221Sampler::getRate() {
+    return _rate;
+}
+
+/*==============================================================================================================*
+    GET PERIOD (uS)
+ *==============================================================================================================*/
+
+unsigned long MCP3221Sampler::getPeriod() {
+    return _period;
+}
+
+/*==============================================================================================================*
+    GET DEADLINE (micros() TIME OF THE NEXT SCHEDULED READ)
+ *==============================================================================================================*/
+
+unsigned long MCP3221Sampler::getDeadline() {
+    if (!_timerDriven) return _started ? _deadline : micros() + _period;  // not started: no read due yet
+    noInterrupts();
+    unsigned long deadline = _ticks ? _tickTime : _tickTime + _period;  // a pending tick is due right away
+    interrupts();
+    return deadline;
+}
+
+/*==============================================================================================================*
+    POLL (CAPTURES A SAMPLE IF A DEADLINE HAS BEEN REACHED)
+ *==============================================================================================================*/
+
+bool MCP3221Sampler::poll(mcp3221_sample_t &sample) {
+    unsigned long now, scheduled;
+    if (_timerDriven) {
+        if (!_ticks) return false;
+        noInterrupts();
+        byte ticks = _ticks;
+        scheduled = _tickTime;                                             // latest tick wins, older ones are missed
+        _ticks = 0;
+        now = micros();                                                    // taken after the tick: never earlier
+        interrupts();
+        _stats.missed += ticks - 1;
+    } else {
+        now = micros();
+        if (!_started) {                                                   // begin() never called: due right away
+            _deadline = now;
+            _fraction = 0;
+            _started = true;
+        }
+        if ((long)(now - _deadline) < 0) return false;
+        unsigned long late = (now - _deadline) / (_period + (_remainder ? 1 : 0));  // whole periods overrun,
+        advance(late);                                                     // at least...
+        while ((long)(now - nextDeadline()) >= 0) {                        // ...and the few a remainder adds
+            advance(1);
+            late++;
+        }
+        _stats.missed += late;
+        scheduled = _deadline;
+        advance(1);
+    }
+    unsigned long jitter = now - scheduled;
+    sample.timestamp = now;
+    unsigned int value;
+    sample.status = _device.readData(value);
+    sample.value = value;
+    _stats.samples++;
+    _stats.totalJitter += jitter;
+    if (jitter > _stats.maxJitter) _stats.maxJitter = jitter;
+    return true;
+}
+
+/*==============================================================================================================*
+    ADVANCE DEADLINE (BY WHOLE PERIODS, CARRYING THE FRACTIONAL uS IN UNITS OF 1/RATE)
+ *==============================================================================================================*/
+
+void MCP3221Sampler::advance(unsigned long periods) {
+    _deadline += periods * _period;
+    while (periods) {
+        unsigned long step = min(periods, 1000UL);                         // step x remainder fits in 32 bits
+        _fraction += step * _remainder;
+        _deadline += _fraction / _rate;
+        _fraction %= _rate;
+        periods -= step;
+    }
+}
+
+unsigned long MCP3221Sampler::nextDeadline() {
+    return _deadline + _period + ((_fraction + _remainder >= _rate) ? 1 : 0);
+}
+
+/*==============================================================================================================*
+    TICK (HARDWARE TIMER MODE: CALL FROM A TIMER ISR RUNNING AT THE SAMPLE RATE)
+ *==============================================================================================================*/
+
+void MCP3221Sampler::tick() {
+    _timerDriven = true;
+    _tickTime = micros();
+    if (_ticks < 255) _ticks++;
+}
+
+/*==============================================================================================================*
+    GET JITTER STATISTICS
+ *==============================================================================================================*/
+
+const mcp3221_jitter_stats_t& MCP3221Sampler::getJitterStats() {
+    return _stats;
+}
+
+/*==============================================================================================================*
+    RESET JITTER STATISTICS
+ *==============================================================================================================*/
+
+void MCP3221Sampler::resetJitterStats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
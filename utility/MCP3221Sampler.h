@@ -0,0 +1,98 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Sampler.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Sampler_h
+#define MCP3221Sampler_h
+
+#include "MCP3221.h"
+
+namespace Mcp3221 {
+
+    typedef struct {
+        uint16_t      value;                            // reading (smoothed by the device's smoothing method)
+        unsigned long timestamp;                        // capture time (micros() at the start of the transaction)
+        byte          status;                           // sample_status_t (stale samples hold the last valid value)
+    } mcp3221_sample_t;
+
+    typedef struct {
+        unsigned long samples;                          // samples captured
+        unsigned long missed;                           // deadlines skipped because the previous one was served late
+        unsigned long maxJitter;                        // worst capture delay after the scheduled time (in uS)
+        unsigned long totalJitter;                      // sum of capture delays (mean = totalJitter / samples)
+    } mcp3221_jitter_stats_t;
+
+/*==============================================================================================================*
+    FIXED-RATE SAMPLER (TIMESTAMPED READINGS ON A DRIFT-FREE SCHEDULE)
+ *==============================================================================================================*/
+
+// Deadlines advance by exactly one period from the previous deadline (not from the previous capture), so the
+// sample rate doesn't drift with loop timing. Periods that aren't a whole number of uS carry the remainder from
+// one deadline to the next, so e.g. 7000 samples per second span exactly one second rather than 7000 x 142uS.
+// By default poll() compares micros() against the next deadline; alternatively a hardware timer ISR may call
+// tick() at the sample rate, in which case the tick time becomes the scheduled time. The I2C read itself always happens in poll(), as the bus can't be used from an ISR.
+
+    class MCP3221Sampler {
+        public:
+            MCP3221Sampler(MCP3221 &device, unsigned long rate);    // rate in samples per second
+            void          begin();                                  // first deadline is one period from now
+                                                                    // (without it the first poll() starts the schedule)
+            void          setRate(unsigned long rate);
+            unsigned long getRate();
+            unsigned long getPeriod();                              // in uS (rounded down)
+            unsigned long getDeadline();                            // micros() time of the next scheduled read
+                                                                    // (one period from now until started)
+            bool          poll(mcp3221_sample_t &sample);           // true when a sample was captured
+            void          tick();                                   // hardware timer mode (call from the ISR)
+            const mcp3221_jitter_stats_t& getJitterStats();
+            void          resetJitterStats();
+        private:
+            MCP3221                &_device;
+            unsigned long           _rate, _period, _remainder, _fraction, _deadline;
+            volatile unsigned long  _tickTime;
+            volatile byte           _ticks;
+            volatile bool           _timerDriven;
+            bool                    _started;
+            mcp3221_jitter_stats_t  _stats;
+            void                    advance(unsigned long periods);
+            unsigned long           nextDeadline();
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
@@ -0,0 +1,264 @@
+/*==============================================================================================================*
+
+    @file     utility/MCP3221Scheduler.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+
+#include "MCP3221Scheduler.h"
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221Scheduler::MCP3221Scheduler(MCP3221_I2C &bus) :
+    _bus(bus),
+    _numJobs(0),
+    _numSamplers(0),
+    _maxWait(SCHED_MAX_WAIT)
+    {
+        resetStats();
+    }
+
+/*==============================================================================================================*
+    SUBMIT JOB (QUEUED UNTIL run() PICKS IT)
+ *==============================================================================================================*/
+
+bool MCP3221Scheduler::submit(mcp3221_job_t job, void *context, sched_priority_t priority, unsigned int stepTime) {
+    if (!job) return false;
+    sched_job_t *entry = queue(context, priority, stepTime);
+    if (!entry) return false;
+    entry->job = job;
+    return true;
+}
+
+/*==============================================================================================================*
+    SUBMIT READ (ONE readData() CALL QUEUED WITH THE JOBS, THE RESULT PASSED TO THE CALLBACK)
+ *==============================================================================================================*/
+
+bool MCP3221Scheduler::submitRead(MCP3221 &device, mcp3221_read_t callback, void *context,
+                                  sched_priority_t priority, unsigned int stepTime) {
+    if (!callback) return false;
+    sched_job_t *entry = queue(context, priority, stepTime);
+    if (!entry) return false;
+    entry->device = &device;
+    entry->onRead = callback;
+    return true;
+}
+
+/*==============================================================================================================*
+    ADD SAMPLER (ITS DEADLINES ARE KEPT CLEAR OF JOB STEPS)
+ *==============================================================================================================*/
+
+bool MCP3221Scheduler::addSampler(MCP3221Sampler &sampler) {
+    if (_numSamplers >= SCHED_MAX_SAMPLERS) return false;
+    _samplers[_numSamplers++] = &sampler;
+    return true;
+}
+
+/*==============================================================================================================*
+    SET MAXIMUM WAIT (IN uS, PER JOB STEP)
+ *==============================================================================================================*/
+
+void MCP3221Scheduler::setMaxWait(unsigned long maxWait) {
+    _maxWait = maxWait;
+}
+
+/*==============================================================================================================*
+    RUN (ONE JOB STEP, CALL ON EVERY PASS OF loop())
+ *==============================================================================================================*/
+
+bool MCP3221Scheduler::run() {
+    if (!_numJobs) return false;
+    if (_bus.requestPending()) {                                                // never cut into an ADC read
+        _readDeferrals++;
+        return false;
+    }
+    unsigned long now = micros();
+    int i = nextJob(now);
+    if (i < 0) {
+        _deadlineDeferrals++;
+        return false;
+    }
+    sched_job_t &entry = _jobs[i];
+    if (!entry.started) {
+        mcp3221_sched_stats_t &stats = _stats[entry.priority];
+        unsigned long delay = now - entry.submitted;
+        stats.jobs++;
+        stats.totalDelay += delay;
+        if (delay > stats.maxDelay) stats.maxDelay = delay;
+        entry.started = true;
+    }
+    if (entry.device) {                                                         // a queued read takes one step
+        unsigned int data = 0;
+        sample_status_t status = entry.device->readData(data);
+        entry.onRead(status, data, entry.context);
+    } else if (!entry.job(_bus, entry.context)) {                               // more steps to come: the wait
+        entry.submitted = micros();                                             // bound restarts for each one
+        return true;
+    }
+    _numJobs--;
+    memmove(&_jobs[i], &_jobs[i + 1], (_numJobs - i) * sizeof(sched_job_t));
+    return true;
+}
+
+/*==============================================================================================================*
+    GET NUMBER OF QUEUED JOBS
+ *==============================================================================================================*/
+
+byte MCP3221Scheduler::getPending() {
+    return _numJobs;
+}
+
+/*==============================================================================================================*
+    GET STATISTICS
+ *==============================================================================================================*/
+
+unsigned long MCP3221Scheduler::getReads() {
+    return _reads;
+}
+
+unsigned long MCP3221Scheduler::getReadDeferrals() {
+    return _readDeferrals;
+}
+
+unsigned long MCP3221Scheduler::getDeadlineDeferrals() {
+    return _deadlineDeferrals;
+}
+
+const mcp3221_sched_stats_t& MCP3221Scheduler::getStats(sched_priority_t priority) {
+    return _stats[min((byte)priority, (byte)(SCHED_PRIORITIES - 1))];
+}
+
+void MCP3221Scheduler::resetStats() {
+    _reads = _readDeferrals = _deadlineDeferrals = 0;
+    memset(_stats, 0, sizeof(_stats));
+}
+
+/*==============================================================================================================*
+    BUS INTERFACE (ADC TRANSACTIONS PASS STRAIGHT THROUGH)
+ *==============================================================================================================*/
+
+void MCP3221Scheduler::beginTransmission(byte devAddr) {
+    _bus.beginTransmission(devAddr);
+}
+
+size_t MCP3221Scheduler::write(byte data) {
+    return _bus.write(data);
+}
+
+byte MCP3221Scheduler::endTransmission() {
+    return _bus.endTransmission();
+}
+
+byte MCP3221Scheduler::requestFrom(byte devAddr, byte numBytes) {
+    _reads++;
+    return _bus.requestFrom(devAddr, numBytes);
+}
+
+int MCP3221Scheduler::available() {
+    return _bus.available();
+}
+
+int MCP3221Scheduler::read() {
+    return _bus.read();
+}
+
+byte MCP3221Scheduler::bufferSize() {
+    return _bus.bufferSize();
+}
+
+bool MCP3221Scheduler::startRequest(byte devAddr, byte numBytes) {
+    _reads++;
+    return _bus.startRequest(devAddr, numBytes);
+}
+
+bool MCP3221Scheduler::requestPending() {
+    return _bus.requestPending();
+}
+
+bool MCP3221Scheduler::recover() {
+    return _bus.recover();
+}
+
+bool MCP3221Scheduler::setClock(uint32_t clock) {
+    return _bus.setClock(clock);
+}
+
+/*==============================================================================================================*
+    QUEUE ENTRY (NULL IF THE QUEUE IS FULL)
+ *==============================================================================================================*/
+
+MCP3221Scheduler::sched_job_t* MCP3221Scheduler::queue(void *context, sched_priority_t priority,
+                                                       unsigned int stepTime) {
+    if (_numJobs >= SCHED_MAX_JOBS) return NULL;
+    sched_job_t &entry = _jobs[_numJobs++];                                     // kept in submission order
+    entry.job = NULL;
+    entry.device = NULL;
+    entry.onRead = NULL;
+    entry.context = context;
+    entry.submitted = micros();
+    entry.stepTime = stepTime;
+    entry.priority = min((byte)priority, (byte)(SCHED_PRIORITIES - 1));
+    entry.started = false;
+    return &entry;
+}
+
+/*==============================================================================================================*
+    NEXT JOB (OVERDUE JOBS FIRST, THEN THE HIGHEST PRIORITY ONE FITTING BEFORE THE NEXT SAMPLER DEADLINE)
+ *==============================================================================================================*/
+
+int MCP3221Scheduler::nextJob(unsigned long now) {
+    int overdue = -1;
+    unsigned long longest = 0;
+    for (byte i=0; i<_numJobs; i++) {                                           // steps restart the wait, so array
+        unsigned long wait = now - _jobs[i].submitted;                          // order isn't age order
+        if ((wait >= _maxWait) && ((overdue < 0) || (wait > longest))) {
+            overdue = i;
+            longest = wait;
+        }
+    }
+    if (overdue >= 0) return overdue;                                           // longest-waiting overdue job
+    long slack = 0x7FFFFFFFL;
+    for (byte i=0; i<_numSamplers; i++) {
+        slack = min(slack, (long)(_samplers[i]->getDeadline() - now));        // negative: a read is due now
+    }
+    int pick = -1;
+    for (byte i=0; i<_numJobs; i++) {
+        if ((long)_jobs[i].stepTime > slack) continue;
+        if ((pick < 0) || (_jobs[i].priority < _jobs[pick].priority)) pick = i;
+    }
+    return pick;
+}
@@ -0,0 +1,137 @@
+/*==============================================================================================================*
+
+    @file     utility/MCP3221Scheduler.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+
+#ifndef MCP3221Scheduler_h
+#define MCP3221Scheduler_h
+
+#include "MCP3221.h"
+#include "MCP3221Sampler.h"
+
+namespace Mcp3221 {
+
+    const byte          SCHED_MAX_JOBS      =     8;    // queued transactions of other bus users
+    const byte          SCHED_MAX_SAMPLERS  =     4;    // MCP3221Sampler deadlines protected from jobs
+    const unsigned long SCHED_MAX_WAIT      = 50000;    // default wait after which a job runs regardless (in uS)
+    const unsigned int  SCHED_STEP_TIME     =  1000;    // default worst-case duration of a job step (in uS)
+    const unsigned int  SCHED_READ_TIME     =   500;    // default worst-case duration of a queued ADC read (in uS)
+
+    typedef enum:byte {
+        SCHED_HIGH   = 0,
+        SCHED_NORMAL = 1,
+        SCHED_LOW    = 2
+    } sched_priority_t;
+
+    const byte SCHED_PRIORITIES = 3;
+
+    typedef bool (*mcp3221_job_t)(MCP3221_I2C &bus, void *context);     // one step, returns true when finished
+    typedef void (*mcp3221_read_t)(sample_status_t status, unsigned int data, void *context);   // queued read done
+
+    typedef struct {
+        unsigned long jobs;                             // jobs started
+        unsigned long maxDelay;                         // worst queueing delay from submit() to first step (in uS)
+        unsigned long totalDelay;                       // sum of queueing delays (mean = totalDelay / jobs)
+    } mcp3221_sched_stats_t;
+
+/*==============================================================================================================*
+    SHARED-BUS TRANSACTION SCHEDULER (OTHER I2C DEVICES QUEUED AROUND THE MCP3221 READS)
+ *==============================================================================================================*/
+
+// Stands between the MCP3221(s) and the real bus: devices given the scheduler through setBus() pass straight
+// through, so an ADC read never waits in the queue. Reads that can wait are queued with submitRead() instead and
+// compete with the jobs of the other devices, the result handed to a callback. Drivers of other devices on the
+// bus (RTC, EEPROM...) submit their transactions as jobs instead of using 'Wire' directly; a job is a function
+// called by run() with the real bus, performing one step (complete transactions only, written with write())
+// and returning false if it needs another step, so e.g. an EEPROM write polls for the end of its write cycle
+// one step per run() rather than blocking the loop.
+// run() picks the highest priority job (oldest first) whose declared step time fits before the nearest deadline
+// of the attached samplers, and holds all jobs while a split-phase ADC read is in flight. A job waiting longer
+// than the maximum wait runs on the next run() regardless, so low priorities are delayed but never starved.
+
+    class MCP3221Scheduler : public MCP3221_I2C {
+        public:
+            MCP3221Scheduler(MCP3221_I2C &bus = MCP3221_defaultI2C());
+            bool          submit(mcp3221_job_t job, void *context, sched_priority_t priority=SCHED_NORMAL,
+                                 unsigned int stepTime=SCHED_STEP_TIME);   // false if the queue is full
+            bool          submitRead(MCP3221 &device, mcp3221_read_t callback, void *context,
+                                     sched_priority_t priority=SCHED_HIGH, unsigned int stepTime=SCHED_READ_TIME);
+            bool          addSampler(MCP3221Sampler &sampler);
+            void          setMaxWait(unsigned long maxWait);
+            bool          run();                                    // runs one job step, true if one ran
+            byte          getPending();
+            unsigned long getReads();                               // ADC transactions passed through
+            unsigned long getReadDeferrals();                       // run() calls held back by an ADC read in flight
+            unsigned long getDeadlineDeferrals();                   // run() calls with no job fitting before a deadline
+            const mcp3221_sched_stats_t& getStats(sched_priority_t priority);
+            void          resetStats();
+            void          beginTransmission(byte devAddr);
+            size_t        write(byte data);
+            byte          endTransmission();
+            byte          requestFrom(byte devAddr, byte numBytes);
+            int           available();
+            int           read();
+            byte          bufferSize();
+            bool          startRequest(byte devAddr, byte numBytes);
+            bool          requestPending();
+            bool          recover();
+            bool          setClock(uint32_t clock);
+        private:
+            typedef struct {
+                mcp3221_job_t  job;
+                MCP3221       *device;                  // queued ADC read (job = NULL)
+                mcp3221_read_t onRead;
+                void          *context;
+                unsigned long  submitted;
+                unsigned int   stepTime;
+                byte           priority;
+                bool           started;
+            } sched_job_t;
+            MCP3221_I2C          &_bus;
+            sched_job_t           _jobs[SCHED_MAX_JOBS];
+            MCP3221Sampler       *_samplers[SCHED_MAX_SAMPLERS];
+            byte                  _numJobs, _numSamplers;
+            unsigned long         _maxWait, _reads, _readDeferrals, _deadlineDeferrals;
+            mcp3221_sched_stats_t _stats[SCHED_PRIORITIES];
+            sched_job_t*          queue(void *context, sched_priority_t priority, unsigned int stepTime);
+            int                   nextJob(unsigned long now);
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
@@ -0,0 +1,235 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Spectrum.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221Spectrum.h"
+
+/*==============================================================================================================*
+    SINE TABLE (QUARTER WAVE, 1/256 TURN STEPS, Q15)
+ *==============================================================================================================*/
+
+const int16_t MCP3221_SINE[65] PROGMEM = {
+        0,   804,  1608,  2411,  3212,  4011,  4808,  5602,  6393,  7180,  7962,  8740,  9512,
+    10279, 11039, 11793, 12540, 13279, 14010, 14733, 15447, 16151, 16846, 17531, 18205, 18868,
+    19520, 20160, 20788, 21403, 22006, 22595, 23170, 23732, 24279, 24812, 25330, 25833, 26320,
+    26791, 27246, 27684, 28106, 28511, 28899, 29269, 29622, 29957, 30274, 30572, 30853, 31114,
+    31357, 31581, 31786, 31972, 32138, 32286, 32413, 32522, 32610, 32679, 32729, 32758, 32767
+};
+
+static int sine(byte angle) {                                                   // angle in 1/256 turns
+    byte index = angle & 0x3F;
+    if (angle & 0x40) index = 64 - index;
+    int value = pgm_read_word(&MCP3221_SINE[index]);
+    return (angle & 0x80) ? -value : value;
+}
+
+/*==============================================================================================================*
+    Q14 MULTIPLY (32-BIT VALUE x Q14 COEFFICIENT, SPLIT SO NO PRODUCT EXCEEDS 32 BITS)
+ *==============================================================================================================*/
+
+// The upper half is scaled with a multiply rather than a left shift, which is undefined for negative values
+// (the compiler still emits a shift).
+
+static long mulQ14(long value, int coeff) {
+    return ((value >> 16) * coeff) * (1L << (16 - GOERTZEL_COEF_BITS)) + (((long)(uint16_t)value * coeff) >> GOERTZEL_COEF_BITS);
+}
+
+/*==============================================================================================================*
+    GOERTZEL BANK
+ *==============================================================================================================*/
+
+MCP3221Goertzel::MCP3221Goertzel(unsigned long sampleRate) :
+    _sampleRate(sampleRate),
+    _numBins(0)
+    {}
+
+void MCP3221Goertzel::setSampleRate(unsigned long sampleRate) {
+    _sampleRate = sampleRate;
+    for (byte bin=0; bin<_numBins; bin++) updateCoefficient(bin);
+}
+
+bool MCP3221Goertzel::addFrequency(unsigned int frequency) {
+    if ((_numBins >= MAX_GOERTZEL_BINS) || (_sampleRate && ((2UL * frequency) >= _sampleRate))) return false;
+    _frequency[_numBins] = frequency;
+    _amplitude[_numBins] = 0;
+    updateCoefficient(_numBins++);
+    return true;
+}
+
+void MCP3221Goertzel::clear() {
+    _numBins = 0;
+}
+
+byte MCP3221Goertzel::getNumBins() {
+    return _numBins;
+}
+
+unsigned int MCP3221Goertzel::getFrequency(byte bin) {
+    return (bin < _numBins) ? _frequency[bin] : 0;
+}
+
+unsigned int MCP3221Goertzel::getAmplitude(byte bin) {
+    return (bin < _numBins) ? _amplitude[bin] : 0;
+}
+
+// s[n] = x[n] + coeff * s[n-1] - s[n-2], coeff = 2cos(2pi * f / fs)
+// |X|^2 = s[N-1]^2 + s[N-2]^2 - coeff * s[N-1] * s[N-2], peak amplitude = 2|X| / N
+
+void MCP3221Goertzel::analyze(const uint16_t *samples, size_t count) {
+    if (!count) return;
+    unsigned long sum = 0;
+    for (size_t i=0; i<count; i++) sum += samples[i];
+    int mean = (sum + (count >> 1)) / count;
+    for (byte bin=0; bin<_numBins; bin++) {
+        int coeff = _coeff[bin];
+        long s1 = 0, s2 = 0;
+        for (size_t i=0; i<count; i++) {
+            long s = (int)(samples[i] - mean) + mulQ14(s1, coeff) - s2;
+            s2 = s1;
+            s1 = s;
+        }
+        int64_t power = (int64_t)s1 * s1 + (int64_t)s2 * s2 - (((int64_t)s1 * s2 * coeff) >> GOERTZEL_COEF_BITS);
+        _amplitude[bin] = (power > 0) ? ((2 * MCP3221_isqrt(power) + (count >> 1)) / count) : 0;
+    }
+}
+
+void MCP3221Goertzel::updateCoefficient(byte bin) {
+    if (!_sampleRate) {
+        _coeff[bin] = 0;
+        return;
+    }
+    long coeff = lround(2.0 * cos(2.0 * M_PI * _frequency[bin] / _sampleRate) * (1L << GOERTZEL_COEF_BITS));
+    _coeff[bin] = constrain(coeff, -32767L, 32767L);                           // 2.0 itself doesn't fit Q14
+}
+
+/*==============================================================================================================*
+    FIXED-POINT FFT
+ *==============================================================================================================*/
+
+MCP3221FFTBase::MCP3221FFTBase(int16_t *re, int16_t *im, unsigned int size, byte log2Size) :
+    _re(re),
+    _im(im),
+    _size(size),
+    _log2Size(log2Size),
+    _sampleRate(0)
+    {
+        for (unsigned int i=0; i<_size; i++) _re[i] = _im[i] = 0;
+    }
+
+void MCP3221FFTBase::setSampleRate(unsigned long sampleRate) {
+    _sampleRate = sampleRate;
+}
+
+void MCP3221FFTBase::analyze(const uint16_t *samples) {
+    unsigned long sum = 0;
+    for (unsigned int i=0; i<_size; i++) sum += samples[i];
+    int mean = (sum + (_size >> 1)) >> _log2Size;
+    for (unsigned int i=0; i<_size; i++) {
+        _re[i] = (int)(samples[i] - mean) * (1 << FFT_INPUT_SHIFT);                // samples below the mean are negative
+        _im[i] = 0;
+    }
+    MCP3221_fft(_re, _im, _log2Size);
+}
+
+// A real sine of amplitude A shows up as A / 2 in its bin (and its mirror) once the 1/SIZE scaling is applied,
+// so the peak amplitude is twice the bin magnitude, less the input scaling.
+
+unsigned int MCP3221FFTBase::getMagnitude(unsigned int bin) {
+    if (bin > (_size >> 1)) return 0;
+    unsigned int magnitude = MCP3221_isqrt(power(bin));
+    return (bin && (bin < (_size >> 1))) ? (magnitude >> (FFT_INPUT_SHIFT - 1)) : (magnitude >> FFT_INPUT_SHIFT);
+}
+
+unsigned int MCP3221FFTBase::getFrequency(unsigned int bin) {
+    return ((unsigned long)bin * _sampleRate + (_size >> 1)) >> _log2Size;
+}
+
+unsigned int MCP3221FFTBase::getPeakBin() {
+    unsigned int peak = 1;
+    unsigned long peakPower = 0;
+    for (unsigned int bin=1; bin<=(_size >> 1); bin++) {
+        unsigned long binPower = power(bin);
+        if (binPower > peakPower) {
+            peakPower = binPower;
+            peak = bin;
+        }
+    }
+    return peak;
+}
+
+unsigned int MCP3221FFTBase::getSize() {
+    return _size;
+}
+
+unsigned long MCP3221FFTBase::power(unsigned int bin) {
+    return (long)_re[bin] * _re[bin] + (long)_im[bin] * _im[bin];
+}
+
+/*==============================================================================================================*
+    FFT (IN PLACE, RADIX-2 DECIMATION IN TIME, EACH STAGE SCALED BY 1/2)
+ *==============================================================================================================*/
+
+void Mcp3221::MCP3221_fft(int16_t *re, int16_t *im, byte log2Size) {
+    unsigned int size = 1 << log2Size;
+    for (unsigned int i=1, j=0; i<size; i++) {                                  // bit-reversed order
+        unsigned int bit = size >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            int16_t temp = re[i]; re[i] = re[j]; re[j] = temp;
+            temp = im[i]; im[i] = im[j]; im[j] = temp;
+        }
+    }
+    for (byte stage=1; stage<=log2Size; stage++) {
+        unsigned int half = 1 << (stage - 1);
+        byte step = 1 << (8 - stage);                                           // twiddle step in 1/256 turns
+        for (unsigned int k=0; k<half; k++) {
+            byte angle = k * step;
+            int wr = sine(angle + 64);                                          // cos
+            int wi = -sine(angle);                                              // -sin (forward transform)
+            for (unsigned int i=k; i<size; i+=(half << 1)) {
+                unsigned int j = i + half;
+                int tr = ((long)wr * re[j] - (long)wi * im[j]) >> 15;
+                int ti = ((long)wr * im[j] + (long)wi * re[j]) >> 15;
+                re[j] = (re[i] - tr) >> 1;
+                im[j] = (im[i] - ti) >> 1;
+                re[i] = (re[i] + tr) >> 1;
+                im[i] = (im[i] + ti) >> 1;
+            }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Spectrum.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Spectrum_h
+#define MCP3221Spectrum_h
+
+#include "MCP3221.h"
+#include "MCP3221Stats.h"
+
+namespace Mcp3221 {
+
+    const byte         MAX_GOERTZEL_BINS  =   8;        // target frequencies per Goertzel bank
+    const byte         GOERTZEL_COEF_BITS =  14;        // fractional bits of the Goertzel coefficients
+    const byte         FFT_INPUT_SHIFT    =   3;        // 12-bit samples are scaled up to 15 bits for the FFT
+    const unsigned int MIN_FFT_SIZE       =   8;
+    const unsigned int MAX_FFT_SIZE       = 256;        // limited by the resolution of the sine table
+
+    void MCP3221_fft(int16_t *re, int16_t *im, byte log2Size);   // in place, output scaled by 1/size
+
+/*==============================================================================================================*
+    GOERTZEL BANK (AMPLITUDES AT A FEW TARGET FREQUENCIES, INTEGER-ONLY PER SAMPLE)
+ *==============================================================================================================*/
+
+// Each target frequency costs one multiply & two adds per sample (the multiply split so it stays in 32 bits on
+// AVR) plus a 64-bit magnitude step per block, so a handful of frequencies are far cheaper than a full FFT.
+// Coefficients are computed (in floating point) only when a frequency or the sample rate is set. The block mean
+// is removed first. Resolution is about sampleRate / blockSize: use blocks spanning whole signal periods.
+
+    class MCP3221Goertzel {
+        public:
+            MCP3221Goertzel(unsigned long sampleRate = 0);
+            void          setSampleRate(unsigned long sampleRate);    // e.g. MCP3221Sampler::getRate()
+            bool          addFrequency(unsigned int frequency);       // in Hz, false if full or above Nyquist
+            void          clear();
+            byte          getNumBins();
+            unsigned int  getFrequency(byte bin);
+            void          analyze(const uint16_t *samples, size_t count);
+            unsigned int  getAmplitude(byte bin);       // peak amplitude of the latest block (in counts)
+        private:
+            unsigned long _sampleRate;
+            unsigned int  _frequency[MAX_GOERTZEL_BINS], _amplitude[MAX_GOERTZEL_BINS];
+            int           _coeff[MAX_GOERTZEL_BINS];
+            byte          _numBins;
+            void          updateCoefficient(byte bin);
+    };
+
+/*==============================================================================================================*
+    FIXED-POINT FFT (SIZE: POWER OF TWO, 8-256 SAMPLES)
+ *==============================================================================================================*/
+
+// Radix-2 FFT on 16-bit integers with the twiddle factors taken from a 65-entry quarter-wave sine table in
+// PROGMEM; every stage halves its results, so nothing overflows and the output comes out scaled by 1/SIZE.
+// analyze() removes the block mean and uses the samples as the real part (rectangular window). RAM: 4 x SIZE
+// bytes for the real & imaginary parts; magnitudes are derived from them on request.
+
+    class MCP3221FFTBase {
+        public:
+            void          setSampleRate(unsigned long sampleRate);
+            void          analyze(const uint16_t *samples);           // SIZE samples
+            unsigned int  getMagnitude(unsigned int bin);               // peak amplitude (in counts), bins 0-SIZE/2
+            unsigned int  getFrequency(unsigned int bin);               // bin centre (in Hz)
+            unsigned int  getPeakBin();                                 // strongest bin (excluding DC)
+            unsigned int  getSize();
+        protected:
+            MCP3221FFTBase(int16_t *re, int16_t *im, unsigned int size, byte log2Size);
+        private:
+            int16_t       *_re, *_im;
+            unsigned int   _size;
+            byte           _log2Size;
+            unsigned long  _sampleRate;
+            unsigned long  power(unsigned int bin);
+    };
+
+    template<unsigned int SIZE> class MCP3221FFT : public MCP3221FFTBase {
+        static_assert((SIZE >= MIN_FFT_SIZE) && (SIZE <= MAX_FFT_SIZE) && !(SIZE & (SIZE - 1)),
+                      "MCP3221FFT: SIZE must be a power of two from 8 to 256");
+        public:
+            MCP3221FFT() : MCP3221FFTBase(_re, _im, SIZE, sizeLog2(SIZE)) {}
+        private:
+            int16_t _re[SIZE], _im[SIZE];
+            static constexpr byte sizeLog2(unsigned int n) { return (n > 1) ? (1 + sizeLog2(n >> 1)) : 0; }
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
@@ -0,0 +1,141 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Stats.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221Stats.h"
+
+/*==============================================================================================================*
+    TUMBLING WINDOW STATISTICS STAGE
+ *==============================================================================================================*/
+
+MCP3221TumblingStats::MCP3221TumblingStats(unsigned int windowSize) :
+    _windowSize(max(windowSize, 1))
+    {
+        reset();
+    }
+
+bool MCP3221TumblingStats::process(unsigned int &sample) {
+    add(sample);
+    return true;
+}
+
+size_t MCP3221TumblingStats::processBlock(uint16_t *samples, size_t count) {
+    for (size_t i=0; i<count; i++) add(samples[i]);
+    return count;
+}
+
+bool MCP3221TumblingStats::available() {
+    return _available;
+}
+
+bool MCP3221TumblingStats::getStats(mcp3221_window_stats_t &stats) {
+    if (!_windows) return false;
+    MCP3221_computeStats(_latched, stats);
+    _available = false;
+    return true;
+}
+
+unsigned long MCP3221TumblingStats::getWindows() {
+    return _windows;
+}
+
+void MCP3221TumblingStats::reset() {
+    _acc.count = 0;
+    _windows = 0;
+    _available = false;
+}
+
+void MCP3221TumblingStats::add(unsigned int sample) {
+    if (!_acc.count) {
+        _acc.min = _acc.max = sample;
+        _acc.sum = 0;
+        _acc.sumSq = 0;
+    } else if (sample < _acc.min) {
+        _acc.min = sample;
+    } else if (sample > _acc.max) {
+        _acc.max = sample;
+    }
+    _acc.sum += sample;
+    _acc.sumSq += (unsigned long)sample * sample;
+    if (++_acc.count < _windowSize) return;
+    _latched = _acc;                                                            // window complete: latch & restart
+    _acc.count = 0;
+    _windows++;
+    _available = true;
+}
+
+/*==============================================================================================================*
+    COMPUTE STATISTICS (MEAN, RMS & STANDARD DEVIATION FROM THE ACCUMULATORS, INTEGER-ONLY)
+ *==============================================================================================================*/
+
+// variance = (n * sumSq - sum^2) / n^2. With n up to 65535 and 12-bit samples n * sumSq stays below 2^56, and
+// dividing by n once before scaling keeps the 1/16-count result within 64 bits.
+
+void Mcp3221::MCP3221_computeStats(const mcp3221_stats_acc_t &acc, mcp3221_window_stats_t &stats) {
+    stats.count = acc.count;
+    if (!acc.count) {
+        stats.min = stats.max = stats.mean = stats.rms = stats.stdDev = 0;
+        return;
+    }
+    unsigned int n = acc.count;
+    stats.min = acc.min;
+    stats.max = acc.max;
+    stats.mean = (((uint64_t)acc.sum << STATS_FRAC_BITS) + (n >> 1)) / n;
+    stats.rms = MCP3221_isqrt((acc.sumSq << (2 * STATS_FRAC_BITS)) / n);
+    uint64_t spread = (uint64_t)n * acc.sumSq - (uint64_t)acc.sum * acc.sum;
+    stats.stdDev = MCP3221_isqrt(((spread / n) << (2 * STATS_FRAC_BITS)) / n);
+}
+
+/*==============================================================================================================*
+    INTEGER SQUARE ROOT (BIT-BY-BIT, FLOOR)
+ *==============================================================================================================*/
+
+uint32_t Mcp3221::MCP3221_isqrt(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
@@ -0,0 +1,162 @@
+/*==============================================================================================================*
+
+    @file     MCP3221Stats.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221Stats_h
+#define MCP3221Stats_h
+
+#include "MCP3221.h"
+#include "MCP3221Filters.h"
+
+namespace Mcp3221 {
+
+    const byte STATS_FRAC_BITS = 4;                     // fractional bits of mean, RMS & standard deviation
+
+    typedef struct {
+        unsigned int  count;                            // samples in the window
+        unsigned int  min, max;                         // in counts
+        unsigned int  mean;                             // in 1/16 counts (STATS_FRAC_BITS)
+        unsigned int  rms;                              // in 1/16 counts
+        unsigned int  stdDev;                           // in 1/16 counts
+    } mcp3221_window_stats_t;
+
+    typedef struct {                                    // raw window accumulators
+        unsigned int  count, min, max;
+        unsigned long sum;
+        uint64_t      sumSq;
+    } mcp3221_stats_acc_t;
+
+    void     MCP3221_computeStats(const mcp3221_stats_acc_t &acc, mcp3221_window_stats_t &stats);
+    uint32_t MCP3221_isqrt(uint64_t value);
+
+/*==============================================================================================================*
+    TUMBLING WINDOW STATISTICS STAGE (CONSECUTIVE, NON-OVERLAPPING WINDOWS OF 'windowSize' SAMPLES)
+ *==============================================================================================================*/
+
+// A pass-through pipeline stage: attach it with addStage() (first, to see raw readings, or after other stages
+// to see filtered ones) and every reading taken by the device is accumulated as it goes by - blocks from
+// readBurst() / read() in place, without copies. Per sample the stage only updates min, max, sum and sum of
+// squares; when a window completes the accumulators are latched, so getStats() returns the latest complete
+// window while the next one is being collected, and mean / RMS / standard deviation are derived (integer-only)
+// only when asked for.
+
+    class MCP3221TumblingStats : public MCP3221Stage {
+        public:
+            MCP3221TumblingStats(unsigned int windowSize);
+            bool          process(unsigned int &sample);
+            size_t        processBlock(uint16_t *samples, size_t count);
+            bool          available();                  // true once a window completed since the last getStats()
+            bool          getStats(mcp3221_window_stats_t &stats);   // false until the first window completes
+            unsigned long getWindows();                 // number of completed windows
+            void          reset();
+        private:
+            mcp3221_stats_acc_t _acc, _latched;
+            unsigned int  _windowSize;
+            unsigned long _windows;
+            bool          _available;
+            void          add(unsigned int sample);
+    };
+
+/*==============================================================================================================*
+    SLIDING WINDOW STATISTICS STAGE (LATEST 'WINDOW' SAMPLES: 2-255)
+ *==============================================================================================================*/
+
+// Keeps the latest WINDOW samples (2 bytes each) with running sums, so each sample costs an add and a subtract
+// for the sums. Min & max are rescanned only when the sample leaving the window held one of them.
+
+    template <byte WINDOW>
+    class MCP3221SlidingStats : public MCP3221Stage {
+        static_assert(WINDOW > 1, "MCP3221SlidingStats: WINDOW must be at least 2");
+        public:
+            MCP3221SlidingStats() {
+                reset();
+            }
+            bool process(unsigned int &sample) {
+                add(sample);
+                return true;
+            }
+            size_t processBlock(uint16_t *samples, size_t count) {
+                for (size_t i=0; i<count; i++) add(samples[i]);
+                return count;
+            }
+            void getStats(mcp3221_window_stats_t &stats) {
+                mcp3221_stats_acc_t acc = { _count, _min, _max, _sum, _sumSq };
+                MCP3221_computeStats(acc, stats);
+            }
+            void reset() {
+                _index = _count = 0;
+                _sum = _sumSq = 0;
+                _min = 0xFFFF;
+                _max = 0;
+            }
+        private:
+            uint16_t      _samples[WINDOW];
+            byte          _index, _count;
+            unsigned int  _min, _max;
+            unsigned long _sum, _sumSq;                 // sumSq: 255 * 4095^2 fits 32 bits
+            void add(unsigned int sample) {
+                bool rescan = false;
+                if (_count < WINDOW) {
+                    _count++;
+                } else {
+                    unsigned int old = _samples[_index];
+                    _sum -= old;
+                    _sumSq -= (unsigned long)old * old;
+                    rescan = ((old == _min) && (sample > _min)) || ((old == _max) && (sample < _max));
+                }
+                _samples[_index] = sample;
+                _sum += sample;
+                _sumSq += (unsigned long)sample * sample;
+                if (++_index >= WINDOW) _index = 0;
+                if (rescan) {
+                    _min = 0xFFFF;
+                    _max = 0;
+                    for (byte i=0; i<_count; i++) {
+                        if (_samples[i] < _min) _min = _samples[i];
+                        if (_samples[i] > _max) _max = _samples[i];
+                    }
+                } else {
+                    if (sample < _min) _min = sample;
+                    if (sample > _max) _max = sample;
+                }
+            }
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
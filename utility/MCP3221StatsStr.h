@@ -0,0 +1,129 @@
+/*==============================================================================================================*
+
+    @file     MCP3221StatsStr.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221StatsStr_h
+#define MCP3221StatsStr_h
+
+#include <avr/pgmspace.h>
+
+namespace Mcp3221 {
+
+    const int  STATS_BUFFER_SIZE = 480;                         // buffer size needed for MCP3221StatsStr()
+    const byte NUM_OF_STATS_STR  =  12;
+
+    const char statsStr0[]  PROGMEM = "\nMCP3221 I2C STATISTICS";
+    const char statsStr1[]  PROGMEM = "\n----------------------";
+    const char statsStr2[]  PROGMEM = "\nREADS:\t\t   ";
+    const char statsStr3[]  PROGMEM = "\nSAMPLES:\t   ";
+    const char statsStr4[]  PROGMEM = "\nSHORT READS:\t   ";
+    const char statsStr5[]  PROGMEM = "\nRETRIES:\t   ";
+    const char statsStr6[]  PROGMEM = "\nPING RESULTS:\t  ";
+    const char statsStr7[]  PROGMEM = "\nREAD TIME:\t   MIN ";
+    const char statsStr8[]  PROGMEM = "uS / MAX ";
+    const char statsStr9[]  PROGMEM = "uS / MEAN ";
+    const char statsStr10[] PROGMEM = "uS\nLATENCY HISTOGRAM (<2uS, <4uS, <8uS ... >=2048uS):\n  ";
+    const char statsStr11[] PROGMEM = "\n(Give the device counters with setComStats() to enable)\n";
+
+    const char * const statsStrs[NUM_OF_STATS_STR] PROGMEM = {
+        statsStr0,
+        statsStr1,
+        statsStr2,
+        statsStr3,
+        statsStr4,
+        statsStr5,
+        statsStr6,
+        statsStr7,
+        statsStr8,
+        statsStr9,
+        statsStr10,
+        statsStr11
+    };
+
+/*==============================================================================================================*
+    PRINT I2C COMMUNICATION STATISTICS (STREAMED FROM PROGMEM, NO BUFFERS)
+ *==============================================================================================================*/
+
+    inline size_t MCP3221PrintComStats(const MCP3221& devParams, Print &out) {
+        size_t n = 0;
+        const mcp3221_com_stats_t& stats = devParams.getComStats();
+        for (byte i=0; i<2; i++) n += out.print((const __FlashStringHelper *) pgm_read_word(&statsStrs[i]));
+        if (!devParams._comStats) return n + out.print((const __FlashStringHelper *) statsStr11);
+        n += out.print((const __FlashStringHelper *) statsStr2);
+        n += out.print(stats.reads);
+        n += out.print((const __FlashStringHelper *) statsStr3);
+        n += out.print(stats.samples);
+        n += out.print((const __FlashStringHelper *) statsStr4);
+        n += out.print(stats.shortReads);
+        n += out.print((const __FlashStringHelper *) statsStr5);
+        n += out.print(stats.retries);
+        n += out.print((const __FlashStringHelper *) statsStr6);
+        for (byte i=0; i<NUM_COM_CODES; i++) {
+            n += out.print(F(" #"));
+            n += out.print(i);
+            n += out.print(F(":"));
+            n += out.print(stats.comCodes[i]);
+        }
+        n += out.print((const __FlashStringHelper *) statsStr7);
+        n += out.print(stats.timedReads ? stats.minTime : 0);
+        n += out.print((const __FlashStringHelper *) statsStr8);
+        n += out.print(stats.maxTime);
+        n += out.print((const __FlashStringHelper *) statsStr9);
+        n += out.print(stats.timedReads ? (stats.totalTime / stats.timedReads) : 0);
+        n += out.print((const __FlashStringHelper *) statsStr10);
+        for (byte i=0; i<NUM_LATENCY_BINS; i++) {
+            n += out.print(F(" "));
+            n += out.print(stats.latency[i]);
+        }
+        n += out.print(F("\n"));
+        return n;
+    }
+
+/*==============================================================================================================*
+    GENERATE I2C COMMUNICATION STATISTICS STRING (PRINTABLE FORMAT, IN A CALLER-PROVIDED BUFFER)
+ *==============================================================================================================*/
+
+    inline MCP3221_PString MCP3221StatsStr(const MCP3221& devParams, char *buffer, size_t size) {
+        MCP3221_PString resultStr(buffer, size);
+        MCP3221PrintComStats(devParams, resultStr);
+        return resultStr;
+    }
+}
+
+using namespace Mcp3221;
+
+#endif
@@ -0,0 +1,208 @@
+/*==============================================================================================================*
+
+    @file     MCP3221T.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221T_h
+#define MCP3221T_h
+
+#include "MCP3221.h"
+
+namespace Mcp3221 {
+
+/*==============================================================================================================*
+    COMPILE-TIME HELPERS
+ *==============================================================================================================*/
+
+    template<unsigned int N> struct MCP3221T_Log2 {
+        static const byte value = 1 + MCP3221T_Log2<N / 2>::value;
+    };
+
+    template<> struct MCP3221T_Log2<1> {
+        static const byte value = 0;
+    };
+
+/*==============================================================================================================*
+    COMPILE-TIME FILTERS (ONLY THE SELECTED FILTER'S STATE IS INSTANTIATED)
+ *==============================================================================================================*/
+
+    template<smoothing_t SMOOTHING, byte WINDOW> class MCP3221T_Filter;
+
+    template<byte WINDOW> class MCP3221T_Filter<NO_SMOOTHING, WINDOW> {       // no state at all
+        protected:
+            unsigned int filter(unsigned int rawData) {
+                return rawData;
+            }
+            void reset() {}
+    };
+
+    template<byte WINDOW> class MCP3221T_Filter<ROLLING_AVG, WINDOW> {        // WINDOW = number of samples
+        static_assert(WINDOW >= 1, "Rolling-Average window must hold at least 1 sample");
+        protected:
+            MCP3221T_Filter() {
+                reset();
+            }
+            unsigned int filter(unsigned int rawData) {
+                if (_count < WINDOW) _count++;
+                else _sum -= _samples[_index];
+                _samples[_index] = rawData;
+                _sum += rawData;
+                if (++_index >= WINDOW) _index = 0;
+                return (_count < WINDOW) ? (_sum / _count) : (_sum / WINDOW);   // constant divisor (shift if 2^n)
+            }
+            void reset() {
+                _index = _count = 0;
+                _sum = 0;
+            }
+        private:
+            uint16_t      _samples[WINDOW];
+            byte          _index, _count;
+            unsigned long _sum;
+    };
+
+    template<byte WINDOW> class MCP3221T_Filter<EMAVG, WINDOW> {              // alpha = 1/WINDOW (not 178/256)
+        static_assert(WINDOW && !(WINDOW & (WINDOW - 1)), "EMAVG window must be a power of two (alpha = 1/WINDOW)");
+        protected:
+            MCP3221T_Filter() {
+                reset();
+            }
+            unsigned int filter(unsigned int rawData) {
+                long target = (long)rawData << EMA_FRAC_BITS;
+                if (_primed) _emAvg += (target - _emAvg) >> MCP3221T_Log2<WINDOW>::value;
+                else _emAvg = target;
+                _primed = true;
+                return (_emAvg + (1L << (EMA_FRAC_BITS - 1))) >> EMA_FRAC_BITS;
+            }
+            void reset() {
+                _primed = false;
+            }
+        private:
+            long _emAvg;
+            bool _primed;
+    };
+
+    template<byte WINDOW> class MCP3221T_Filter<MEDIAN, WINDOW> {             // WINDOW = odd number of samples
+        static_assert((WINDOW & 1) && (WINDOW <= MAX_MEDIAN_WINDOW), "Median window must be odd and at most 9 samples");
+        protected:
+            MCP3221T_Filter() {
+                reset();
+            }
+            unsigned int filter(unsigned int rawData) {
+                uint16_t sorted[WINDOW];
+                _samples[_index] = rawData;
+                if (++_index >= WINDOW) _index = 0;
+                if (_count < WINDOW) _count++;
+                for (byte i=0; i<_count; i++) sorted[i] = _samples[i];
+                return MCP3221_median(sorted, _count);
+            }
+            void reset() {
+                _index = _count = 0;
+            }
+        private:
+            uint16_t _samples[WINDOW];
+            byte     _index, _count;
+    };
+
+/*==============================================================================================================*
+    COMPILE-TIME CONFIGURED MCP3221 DRIVER
+ *==============================================================================================================*/
+
+// Filter, window, voltage scaling and the bus type are template parameters, so unused state is never allocated
+// and getData() / getVoltage() inline to a straight read-filter-scale sequence. The bus is used through its own
+// type (by default 'TwoWire' itself) rather than the virtual MCP3221_I2C interface, so the compiler sees each
+// call; any class with the Wire-style transaction methods will do (e.g. MCP3221_SimI2C). Unlike the MCP3221
+// class, a failed read is not retried and EMAVG uses alpha = 1/WINDOW (default 1/8) instead of the runtime
+// default of 178/256. The runtime-configurable MCP3221 class is unaffected; use this variant when a channel's
+// configuration is fixed, e.g.:
+//
+//     MCP3221T<0x4D, ROLLING_AVG, 16> adc;                        // 16-sample Rolling-Average, 5V input
+//     MCP3221T<0x4E, NO_SMOOTHING, 1, VOLTAGE_INPUT_12V> rail;    // raw counts, 10K/4K7 voltage divider
+
+    template<
+             byte            DEV_ADDR,
+             smoothing_t     SMOOTHING     = EMAVG,
+             byte            WINDOW        = 8,
+             voltage_input_t VOLTAGE_INPUT = VOLTAGE_INPUT_5V,
+             unsigned int    VREF          = DEFAULT_VREF,
+             unsigned int    RES_1         = DEFAULT_RES_1,
+             unsigned int    RES_2         = DEFAULT_RES_2,
+             typename        BUS           = TwoWire
+            >
+    class MCP3221T : private MCP3221T_Filter<SMOOTHING, WINDOW> {
+        public:
+            MCP3221T(BUS &bus = Wire) : _bus(bus), _comBuffer(COM_SUCCESS), _data(0) {}
+            byte ping() {
+                _bus.beginTransmission(DEV_ADDR);
+                return _comBuffer = _bus.endTransmission();
+            }
+            unsigned int getData() {                                 // no retries, holds the last value on failure
+                unsigned int rawData;
+                if (readRawData(rawData)) _data = this->filter(rawData);
+                return _data;
+            }
+            unsigned int getVoltage() {                                            // in mV
+                return ((unsigned long)getData() * VOLTAGE_SCALE + 2048) >> 12;
+            }
+            byte getComResult() {
+                return _comBuffer;
+            }
+            void resetFilter() {
+                this->reset();
+            }
+        private:
+            static const unsigned long VOLTAGE_SCALE = (VOLTAGE_INPUT == VOLTAGE_INPUT_5V) ?  // mV per count (Q12)
+                                                       (unsigned long)VREF :
+                                                       ((((unsigned long)RES_1 + RES_2) << 12) + RES_2 / 2) / RES_2;
+            BUS         &_bus;
+            byte         _comBuffer;
+            unsigned int _data;
+            bool readRawData(unsigned int &rawData) {
+                _bus.requestFrom(DEV_ADDR, DATA_BYTES);
+                if (_bus.available() != DATA_BYTES) {
+                    ping();
+                    return false;
+                }
+                rawData = _bus.read() << 8;
+                rawData |= _bus.read();
+                _comBuffer = COM_SUCCESS;
+                return true;
+            }
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
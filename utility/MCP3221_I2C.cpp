@@ -0,0 +1,176 @@
+/*==============================================================================================================*
+
+    @file     MCP3221_I2C.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221_I2C.h"
+
+/*==============================================================================================================*
+    DEFAULT RECEIVE BUFFER SIZE
+ *==============================================================================================================*/
+
+byte MCP3221_I2C::bufferSize() {
+    return 32;
+}
+
+/*==============================================================================================================*
+    DEFAULT WRITE (READ-ONLY BUS, NOTHING QUEUED)
+ *==============================================================================================================*/
+
+size_t MCP3221_I2C::write(byte) {
+    return 0;
+}
+
+/*==============================================================================================================*
+    DEFAULT SPLIT-PHASE READ
+ *==============================================================================================================*/
+
+// Interrupt-driven buses override both methods: startRequest() only kicks off the transfer and the bus's
+// completion ISR calls MCP3221::onTransferComplete(). Blocking buses simply finish before returning; this
+// includes the 'Wire' adapter below, as the library provides no interrupt-driven bus of its own.
+
+bool MCP3221_I2C::startRequest(byte devAddr, byte numBytes) {
+    return requestFrom(devAddr, numBytes) > 0;
+}
+
+bool MCP3221_I2C::requestPending() {
+    return false;
+}
+
+/*==============================================================================================================*
+    DEFAULT BUS RECOVERY
+ *==============================================================================================================*/
+
+bool MCP3221_I2C::recover() {
+    return false;
+}
+
+/*==============================================================================================================*
+    DEFAULT CLOCK SETTING
+ *==============================================================================================================*/
+
+bool MCP3221_I2C::setClock(uint32_t) {
+    return false;
+}
+
+/*==============================================================================================================*
+    WIRE ADAPTER
+ *==============================================================================================================*/
+
+MCP3221_WireI2C::MCP3221_WireI2C(TwoWire& wire, byte sdaPin, byte sclPin) :
+    _wire(wire),
+    _sdaPin(sdaPin),
+    _sclPin(sclPin),
+    _clock(0) {}
+
+void MCP3221_WireI2C::beginTransmission(byte devAddr) {
+    _wire.beginTransmission(devAddr);
+}
+
+size_t MCP3221_WireI2C::write(byte data) {
+    return _wire.write(data);
+}
+
+byte MCP3221_WireI2C::endTransmission() {
+    return _wire.endTransmission();
+}
+
+byte MCP3221_WireI2C::requestFrom(byte devAddr, byte numBytes) {
+    return _wire.requestFrom(devAddr, numBytes);
+}
+
+int MCP3221_WireI2C::available() {
+    return _wire.available();
+}
+
+int MCP3221_WireI2C::read() {
+    return _wire.read();
+}
+
+bool MCP3221_WireI2C::setClock(uint32_t clock) {
+    _wire.setClock(clock);
+    _clock = clock;
+    return true;
+}
+
+byte MCP3221_WireI2C::bufferSize() {
+    #if defined(BUFFER_LENGTH)
+        return BUFFER_LENGTH;
+    #else
+        return MCP3221_I2C::bufferSize();
+    #endif
+}
+
+/*==============================================================================================================*
+    WIRE ADAPTER BUS RECOVERY (RETURNS TRUE IF BOTH LINES ARE RELEASED AFTERWARDS)
+ *==============================================================================================================*/
+
+// A slave reset mid-transfer may hold SDA low while waiting for clocks that never come. With the TWI peripheral
+// disabled, SCL is pulsed (open-drain, relying on the bus pull-ups) up to 9 times until SDA is released, then a
+// STOP condition is generated and the 'Wire' library is restarted (at the clock rate set through setClock()).
+
+bool MCP3221_WireI2C::recover() {
+    if ((_sdaPin == 255) || (_sclPin == 255)) return false;
+    _wire.end();
+    pinMode(_sdaPin, INPUT);
+    pinMode(_sclPin, INPUT);
+    digitalWrite(_sdaPin, LOW);
+    digitalWrite(_sclPin, LOW);
+    for (byte i=0; (i<9) && !digitalRead(_sdaPin); i++) {
+        pinMode(_sclPin, OUTPUT);                                               // SCL low
+        delayMicroseconds(5);
+        pinMode(_sclPin, INPUT);                                                // SCL released (high)
+        delayMicroseconds(5);
+    }
+    pinMode(_sdaPin, OUTPUT);                                                   // STOP: SDA low -> high while SCL high
+    delayMicroseconds(5);
+    pinMode(_sdaPin, INPUT);
+    delayMicroseconds(5);
+    bool released = digitalRead(_sdaPin) && digitalRead(_sclPin);
+    _wire.begin();
+    if (_clock) _wire.setClock(_clock);
+    return released;
+}
+
+/*==============================================================================================================*
+    DEFAULT BUS (GLOBAL 'WIRE' OBJECT)
+ *==============================================================================================================*/
+
+static MCP3221_WireI2C wireI2C(Wire);
+
+MCP3221_I2C& Mcp3221::MCP3221_defaultI2C() {
+    return wireI2C;
+}
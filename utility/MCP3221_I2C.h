@@ -0,0 +1,101 @@
+/*==============================================================================================================*
+
+    @file     MCP3221_I2C.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221_I2C_h
+#define MCP3221_I2C_h
+
+#include <Arduino.h>
+#include <Wire.h>
+
+namespace Mcp3221 {
+
+/*==============================================================================================================*
+    I2C BUS INTERFACE (USED BY THE MCP3221 FOR ALL BUS TRANSACTIONS)
+ *==============================================================================================================*/
+
+    class MCP3221_I2C {
+        public:
+            virtual void beginTransmission(byte devAddr) = 0;
+            virtual size_t write(byte data);                          // queues a byte to send (default: unsupported, 0)
+            virtual byte endTransmission() = 0;                       // 0 = success / 1, 2, ... = I2C error code
+            virtual byte requestFrom(byte devAddr, byte numBytes) = 0; // returns number of bytes received
+            virtual int  available() = 0;
+            virtual int  read() = 0;
+            virtual byte bufferSize();                                // max bytes per requestFrom() (default: 32)
+            virtual bool startRequest(byte devAddr, byte numBytes);   // split-phase read (default: blocking)
+            virtual bool requestPending();                            // true while a started read is in flight
+            virtual bool recover();                                   // bus clear (default: unsupported, false)
+            virtual bool setClock(uint32_t clock);                    // SCL rate in Hz (default: unsupported, false)
+    };
+
+/*==============================================================================================================*
+    DEFAULT IMPLEMENTATION (ARDUINO 'WIRE' LIBRARY, BLOCKING)
+ *==============================================================================================================*/
+
+    #if defined(PIN_WIRE_SDA) && defined(PIN_WIRE_SCL)
+        const byte WIRE_SDA_PIN = PIN_WIRE_SDA;
+        const byte WIRE_SCL_PIN = PIN_WIRE_SCL;
+    #else
+        const byte WIRE_SDA_PIN = 255;                                // unknown: bus recovery unsupported
+        const byte WIRE_SCL_PIN = 255;
+    #endif
+
+    class MCP3221_WireI2C : public MCP3221_I2C {
+        public:
+            MCP3221_WireI2C(TwoWire& wire, byte sdaPin = WIRE_SDA_PIN, byte sclPin = WIRE_SCL_PIN);
+            void beginTransmission(byte devAddr);
+            size_t write(byte data);
+            byte endTransmission();
+            byte requestFrom(byte devAddr, byte numBytes);
+            int  available();
+            int  read();
+            byte bufferSize();
+            bool recover();
+            bool setClock(uint32_t clock);
+        private:
+            TwoWire& _wire;
+            byte     _sdaPin, _sclPin;
+            uint32_t _clock;                                          // 0 = library default
+    };
+
+    MCP3221_I2C& MCP3221_defaultI2C();                                // shared adapter for the global 'Wire' object
+}
+
+using namespace Mcp3221;
+
+#endif
@@ -0,0 +1,109 @@
+/*==============================================================================================================*
+
+    @file     MCP3221_Ring.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221_Ring_h
+#define MCP3221_Ring_h
+
+#include <Arduino.h>
+
+namespace Mcp3221 {
+
+/*==============================================================================================================*
+    SINGLE-PRODUCER / SINGLE-CONSUMER SAMPLE RING (LOCK-FREE ON AVR: INDICES ARE SINGLE BYTES)
+ *==============================================================================================================*/
+
+// The producer (push) may run inside an ISR while the consumer (pop) runs in the main loop. Each index is
+// written by one side only, so no interrupt masking is needed (except in clear(), which also resets the overrun
+// count written by the producer). The slots are volatile like the indices, so the compiler can't move a slot's
+// write past the index publishing it, nor its read ahead of the index. One slot is kept free to tell full from
+// empty.
+
+    class MCP3221_RingBase {
+        public:
+            byte available() {
+                byte head = _head;
+                return (head >= _tail) ? (head - _tail) : (head + _size - _tail);
+            }
+            byte capacity() {
+                return _size - 1;
+            }
+            bool push(uint16_t sample) {
+                byte next = (_head + 1 < _size) ? (_head + 1) : 0;
+                if (next == _tail) {
+                    if (_overruns < 255) _overruns++;                  // saturating, single byte stays atomic
+                    return false;
+                }
+                _buffer[_head] = sample;
+                _head = next;
+                return true;
+            }
+            bool pop(uint16_t &sample) {
+                byte tail = _tail;
+                if (tail == _head) return false;
+                sample = _buffer[tail];
+                _tail = (tail + 1 < _size) ? (tail + 1) : 0;
+                return true;
+            }
+            byte getOverruns() {
+                return _overruns;
+            }
+            void clear() {                                             // consumer side, masks the producer's ISR
+                noInterrupts();
+                _tail = _head;
+                _overruns = 0;
+                interrupts();
+            }
+        protected:
+            MCP3221_RingBase(uint16_t *buffer, byte size) : _buffer(buffer), _size(size), _head(0), _tail(0), _overruns(0) {}
+        private:
+            volatile uint16_t *_buffer;
+            byte               _size;
+            volatile byte      _head, _tail, _overruns;
+    };
+
+    template<byte SIZE> class MCP3221_Ring : public MCP3221_RingBase {
+        public:
+            MCP3221_Ring() : MCP3221_RingBase(_storage, SIZE) {}
+        private:
+            uint16_t _storage[SIZE];
+    };
+}
+
+using namespace Mcp3221;
+
+#endif
@@ -0,0 +1,251 @@
+/*==============================================================================================================*
+
+    @file     MCP3221_SimI2C.cpp
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#include "MCP3221_SimI2C.h"
+
+const int simSineTable[17] PROGMEM = {                     // first quarter of a sine wave (Q15)
+        0,  3212,  6393,  9512, 12539, 15446, 18204, 20787,
+    23170, 25329, 27245, 28898, 30273, 31356, 32137, 32609, 32767
+};
+
+/*==============================================================================================================*
+    CONSTRUCTOR
+ *==============================================================================================================*/
+
+MCP3221_SimI2C::MCP3221_SimI2C(byte devAddr) :
+    _devAddr(devAddr),
+    _txAddr(0),
+    _txLen(0),
+    _wave(SIM_CONSTANT),
+    _rxLen(0),
+    _rxPos(0),
+    _nonBlocking(false),
+    _stuck(false),
+    _offset(0),
+    _amplitude(0),
+    _period(DEFAULT_SIM_PERIOD),
+    _phase(0),
+    _noise(0),
+    _lfsr(0xACE1),
+    _nackEvery(0),
+    _shortEvery(0),
+    _latency(0),
+    _transactions(0),
+    _conversions(0),
+    _recoveries(0),
+    _readyAt(0),
+    _clock(100000),
+    _clockLimit(0)
+    {}
+
+/*==============================================================================================================*
+    SET WAVEFORM (RAMP / SQUARE / TRIANGLE RISE FROM OFFSET, SINE SWINGS AROUND OFFSET)
+ *==============================================================================================================*/
+
+void MCP3221_SimI2C::setWaveform(sim_waveform_t wave, unsigned int offset, unsigned int amplitude, unsigned int period) {
+    _wave = wave;
+    _offset = offset;
+    _amplitude = amplitude;
+    _period = period ? period : 1;
+    _phase = 0;
+}
+
+/*==============================================================================================================*
+    SET NOISE / FAULT INJECTION / LATENCY
+ *==============================================================================================================*/
+
+void MCP3221_SimI2C::setNoise(unsigned int amplitude) {
+    _noise = amplitude;
+}
+
+void MCP3221_SimI2C::setNackEvery(unsigned int n) {
+    _nackEvery = n;
+}
+
+void MCP3221_SimI2C::setShortReadEvery(unsigned int n) {
+    _shortEvery = n;
+}
+
+void MCP3221_SimI2C::setLatency(unsigned int latency) {
+    _latency = latency;
+}
+
+void MCP3221_SimI2C::setNonBlocking(bool nonBlocking) {
+    _nonBlocking = nonBlocking;
+}
+
+void MCP3221_SimI2C::setBusStuck(bool stuck) {
+    _stuck = stuck;
+}
+
+void MCP3221_SimI2C::setClockLimit(uint32_t maxClock) {
+    _clockLimit = maxClock;
+}
+
+/*==============================================================================================================*
+    GET SIMULATION COUNTERS
+ *==============================================================================================================*/
+
+unsigned long MCP3221_SimI2C::getTransactions() {
+    return _transactions;
+}
+
+unsigned long MCP3221_SimI2C::getConversions() {
+    return _conversions;
+}
+
+unsigned long MCP3221_SimI2C::getRecoveries() {
+    return _recoveries;
+}
+
+/*==============================================================================================================*
+    I2C BUS INTERFACE
+ *==============================================================================================================*/
+
+void MCP3221_SimI2C::beginTransmission(byte devAddr) {
+    _txAddr = devAddr;
+    _txLen = 0;
+}
+
+size_t MCP3221_SimI2C::write(byte) {
+    if (_txLen >= SIM_BUFFER_SIZE) return 0;                           // transmit buffer full, as in 'Wire'
+    _txLen++;
+    return 1;
+}
+
+byte MCP3221_SimI2C::endTransmission() {
+    if (startTransaction(_txAddr)) return 0;
+    return _stuck ? 4 : 2;                                             // 4 = Bus error / 2 = Address NACK'ed
+}
+
+byte MCP3221_SimI2C::requestFrom(byte devAddr, byte numBytes) {
+    _rxLen = _rxPos = 0;
+    if (!startTransaction(devAddr)) return 0;
+    byte len = (numBytes < SIM_BUFFER_SIZE) ? numBytes : SIM_BUFFER_SIZE;
+    if (len && _shortEvery && !(_transactions % _shortEvery)) len--;
+    for (byte i=0; i<len; i+=2) {                                      // device keeps converting while ACK'ed
+        unsigned int conversion = nextConversion();
+        _rxBuffer[i] = highByte(conversion);
+        if ((i + 1) < len) _rxBuffer[i + 1] = lowByte(conversion);
+    }
+    return _rxLen = len;
+}
+
+bool MCP3221_SimI2C::startRequest(byte devAddr, byte numBytes) {
+    if (!_nonBlocking) return MCP3221_I2C::startRequest(devAddr, numBytes);
+    unsigned int latency = _latency;
+    _latency = 0;                                                      // latency elapses while the caller runs
+    byte received = requestFrom(devAddr, numBytes);
+    _latency = latency;
+    _readyAt = micros() + latency;
+    return received > 0;
+}
+
+bool MCP3221_SimI2C::requestPending() {
+    return _nonBlocking && ((long)(micros() - _readyAt) < 0);
+}
+
+int MCP3221_SimI2C::available() {
+    return _rxLen - _rxPos;
+}
+
+int MCP3221_SimI2C::read() {
+    return (_rxPos < _rxLen) ? _rxBuffer[_rxPos++] : -1;
+}
+
+byte MCP3221_SimI2C::bufferSize() {
+    return SIM_BUFFER_SIZE;
+}
+
+bool MCP3221_SimI2C::setClock(uint32_t clock) {
+    _clock = clock;
+    return true;
+}
+
+bool MCP3221_SimI2C::recover() {
+    _stuck = false;
+    _rxLen = _rxPos = 0;
+    _recoveries++;
+    return true;
+}
+
+/*==============================================================================================================*
+    START TRANSACTION (FALSE = ADDRESS NACK'ED)
+ *==============================================================================================================*/
+
+bool MCP3221_SimI2C::startTransaction(byte devAddr) {
+    _transactions++;
+    if (_latency) delayMicroseconds(_latency);
+    if (_stuck || (devAddr != _devAddr)) return false;
+    if (_clockLimit && (_clock > _clockLimit)) {                       // marginal wiring: every n-th transaction
+        uint32_t every = _clockLimit / (_clock - _clockLimit);         // fails, n shrinking as the clock rises
+        if ((every < 2) || !(_transactions % every)) return false;
+    }
+    return !(_nackEvery && !(_transactions % _nackEvery));
+}
+
+/*==============================================================================================================*
+    NEXT CONVERSION RESULT (0 - 4095)
+ *==============================================================================================================*/
+
+unsigned int MCP3221_SimI2C::nextConversion() {
+    unsigned int pos = _phase;
+    unsigned int half = _period / 2;
+    long value = _offset;
+    if (++_phase >= _period) _phase = 0;
+    switch (_wave) {
+        case (SIM_RAMP):     value += (unsigned long)_amplitude * pos / _period; break;
+        case (SIM_SQUARE):   if (pos >= half) value += _amplitude; break;
+        case (SIM_TRIANGLE): if (half) value += (unsigned long)_amplitude * ((pos < half) ? pos : (_period - pos)) / half; break;
+        case (SIM_SINE): {
+            byte idx = (unsigned long)pos * 64 / _period;                  // 64 steps per cycle
+            byte quarter = idx & 15;
+            long sine = pgm_read_word(&simSineTable[(idx & 16) ? (16 - quarter) : quarter]);
+            value += ((idx & 32) ? -sine : sine) * (long)_amplitude / 32767;
+            break;
+        }
+    }
+    if (_noise) {
+        _lfsr ^= _lfsr << 7;                                               // xorshift16 pseudo-random noise
+        _lfsr ^= _lfsr >> 9;
+        _lfsr ^= _lfsr << 8;
+        value += (long)(_lfsr % (2UL * _noise + 1)) - (long)_noise;
+    }
+    _conversions++;
+    return constrain(value, 0L, (long)SIM_MAX_DATA);
+}
@@ -0,0 +1,107 @@
+/*==============================================================================================================*
+
+    @file     MCP3221_SimI2C.h
+    @author   Nadav Matalon
+    @license  MIT (c) 2016 Nadav Matalon
+
+    MCP3221 Driver (12-BIT Single Channel ADC with I2C Interface)
+
+    Ver. 1.0.0 - First release (16.10.16)
+
+ *===============================================================================================================*
+    LICENSE
+ *===============================================================================================================*
+
+    The MIT License (MIT)
+    Copyright (c) 2016 Nadav Matalon
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+    documentation files (the "Software"), to deal in the Software without restriction, including without
+    limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial
+    portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+    LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ *==============================================================================================================*/
+
+#if 1
+__asm volatile ("nop");
+#endif
+
+#ifndef MCP3221_SimI2C_h
+#define MCP3221_SimI2C_h
+
+#include "MCP3221_I2C.h"
+
+namespace Mcp3221 {
+
+    const byte         SIM_BUFFER_SIZE     =    32;     // same receive buffer length as the AVR Wire library
+    const unsigned int SIM_MAX_DATA        =  4095;     // full-scale 12-bit conversion result
+    const unsigned int DEFAULT_SIM_PERIOD  =   100;     // default waveform period (in conversions)
+
+    typedef enum:byte {
+        SIM_CONSTANT = 0,   // default
+        SIM_RAMP     = 1,
+        SIM_SQUARE   = 2,
+        SIM_TRIANGLE = 3,
+        SIM_SINE     = 4
+    } sim_waveform_t;
+
+/*==============================================================================================================*
+    SIMULATED MCP3221 (REPLACES THE I2C BUS FOR HOST BUILDS, BENCHMARKS & REGRESSION TESTING)
+ *==============================================================================================================*/
+
+    class MCP3221_SimI2C final : public MCP3221_I2C {
+        public:
+            MCP3221_SimI2C(byte devAddr);
+            void          setWaveform(
+                                      sim_waveform_t wave,
+                                      unsigned int   offset,
+                                      unsigned int   amplitude = 0,
+                                      unsigned int   period    = DEFAULT_SIM_PERIOD
+                                     );
+            void          setNoise(unsigned int amplitude);         // peak noise amplitude (in counts)
+            void          setNackEvery(unsigned int n);             // NACK every n-th transaction (0 = never)
+            void          setShortReadEvery(unsigned int n);        // drop last byte of every n-th read (0 = never)
+            void          setLatency(unsigned int latency);         // clock-stretch delay per transaction (in uS)
+            void          setNonBlocking(bool nonBlocking);         // split-phase reads complete after the latency
+            void          setBusStuck(bool stuck);                  // bus errors (code 4) until recover() is called
+            void          setClockLimit(uint32_t maxClock);         // NACKs grow with the clock above it (0 = none)
+            unsigned long getTransactions();
+            unsigned long getConversions();
+            unsigned long getRecoveries();
+            void          beginTransmission(byte devAddr);
+            size_t        write(byte data);                         // no registers to write: bytes are discarded
+            byte          endTransmission();
+            byte          requestFrom(byte devAddr, byte numBytes);
+            int           available();
+            int           read();
+            byte          bufferSize();
+            bool          startRequest(byte devAddr, byte numBytes);
+            bool          requestPending();
+            bool          recover();
+            bool          setClock(uint32_t clock);
+        private:
+            byte          _devAddr, _txAddr, _txLen, _wave, _rxLen, _rxPos;
+            bool          _nonBlocking, _stuck;
+            unsigned int  _offset, _amplitude, _period, _phase, _noise, _lfsr;
+            unsigned int  _nackEvery, _shortEvery, _latency;
+            unsigned long _transactions, _conversions, _recoveries, _readyAt;
+            uint32_t      _clock, _clockLimit;
+            byte          _rxBuffer[SIM_BUFFER_SIZE];
+            bool          startTransaction(byte devAddr);
+            unsigned int  nextConversion();
+    };
+}
+
+using namespace Mcp3221;
+
+#endif